@@ -423,6 +423,44 @@ void Column::replaceValues(int first, const QVector<double>& new_values)
     }
 }
 
+/**
+ * \brief Return the minimum and the maximum of the rows \c first to \c last
+ *
+ * NaNs are ignored. The values of numeric columns are taken from a min/max pyramid that is
+ * calculated on the first request and updated for the changed rows only, e.g. for appended rows.
+ * Values changed directly via data() are taken into account after setChanged() was called.
+ */
+void Column::minMax(int first, int last, double& min, double& max) const {
+	m_column_private->minMax(first, last, min, max);
+}
+
+/**
+ * \brief Return \c true if the column is numeric, doesn't contain NaNs and the values don't decrease
+ */
+bool Column::isMonotonicIncreasing() const {
+	return m_column_private->isMonotonicIncreasing();
+}
+
+/**
+ * \brief Return the number of changes of the column so far
+ *
+ * Together with firstChangedRow() this allows to process only the rows changed since a revision, e.g. appended rows.
+ */
+quint64 Column::revision() const {
+	return m_column_private->revision();
+}
+
+/**
+ * \brief Return the first row changed since the revision \c revision returned by revision()
+ *
+ * Returns rowCount() if the column wasn't changed. The returned row may be smaller than the actually first changed row
+ * if the column was changed very often since \c revision, but never larger.
+ * Values changed directly via data() are taken into account after setChanged() was called.
+ */
+int Column::firstChangedRow(quint64 revision) const {
+	return m_column_private->firstChangedRow(revision);
+}
+
 void Column::setStatisticsAvailable(bool available) {
 	m_column_private->statisticsAvailable = available;
 }
@@ -606,6 +644,7 @@ double Column::valueAt(int row) const
  * This is used e.g. in \c XYFitCurvePrivate::recalculate()
  */
 void Column::setChanged() {
+	m_column_private->rowsChanged(0);
 	if (!m_suppressDataChangedSignal)
 		emit dataChanged(this);
 
@@ -126,6 +126,10 @@ class Column : public AbstractColumn {
 		double valueAt(int row) const;
 		void setValueAt(int row, double new_value);
 		virtual void replaceValues(int first, const QVector<double>& new_values);
+		void minMax(int first, int last, double& min, double& max) const;
+		bool isMonotonicIncreasing() const;
+		quint64 revision() const;
+		int firstChangedRow(quint64 revision) const;
 		void setChanged();
 		void setSuppressDataChangedSignal(bool);
 
@@ -44,6 +44,9 @@
 #include "backend/core/datatypes/DayOfWeek2DoubleFilter.h"
 #include "backend/core/datatypes/Month2DoubleFilter.h"
 
+#include <QThreadPool>
+#include <cmath>
+
 
 /**
  * \class ColumnPrivate
@@ -97,7 +100,8 @@
  * \brief Ctor
  */
 ColumnPrivate::ColumnPrivate(Column* owner, AbstractColumn::ColumnMode mode)
- : m_owner(owner) {
+ : m_owner(owner), m_minMaxData(0), m_minMaxRows(0), m_sortedRows(0),
+   m_revision(0) {
 	Q_ASSERT(owner != 0); // a ColumnPrivate without owner is not allowed
 					      // because the owner must become the parent aspect of the input and output filters
 	m_column_mode = mode;
@@ -143,7 +147,8 @@ ColumnPrivate::ColumnPrivate(Column* owner, AbstractColumn::ColumnMode mode)
  * \brief Special ctor (to be called from Column only!)
  */
 ColumnPrivate::ColumnPrivate(Column * owner, AbstractColumn::ColumnMode mode, void * data)
-	: m_owner(owner) {
+	: m_owner(owner), m_minMaxData(0), m_minMaxRows(0), m_sortedRows(0),
+	m_revision(0) {
 	m_column_mode = mode;
 	m_data = data;
 
@@ -230,6 +235,7 @@ AbstractColumn::ColumnMode ColumnPrivate::columnMode() const {
  */
 void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 	if (mode == m_column_mode) return;
+	rowsChanged(0);
 
 	void * old_data = m_data;
 	// remark: the deletion of the old data will be done in the dtor of a command
@@ -420,6 +426,7 @@ void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void * data
 
 	m_column_mode = mode;
 	m_data = data;
+	rowsChanged(0);
 
 	in_filter->setName("InputFilter");
 	out_filter->setName("OutputFilter");
@@ -453,6 +460,7 @@ void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void * data
 void ColumnPrivate::replaceData(void * data) {
 	emit m_owner->dataAboutToChange(m_owner);
 	m_data = data;
+	rowsChanged(0);
 	if (!m_owner->m_suppressDataChangedSignal)
 		emit m_owner->dataChanged(m_owner);
 }
@@ -469,6 +477,7 @@ bool ColumnPrivate::copy(const AbstractColumn * other) {
 	int num_rows = other->rowCount();
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(0);
 	resizeTo(num_rows);
 
 	// copy the data
@@ -517,6 +526,7 @@ bool ColumnPrivate::copy(const AbstractColumn * source, int source_start, int de
 	if (num_rows == 0) return true;
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(dest_start);
 	if (dest_start + num_rows > rowCount())
 		resizeTo(dest_start + num_rows);
 
@@ -559,6 +569,7 @@ bool ColumnPrivate::copy(const ColumnPrivate * other) {
 	int num_rows = other->rowCount();
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(0);
 	resizeTo(num_rows);
 
 	// copy the data
@@ -607,6 +618,7 @@ bool ColumnPrivate::copy(const ColumnPrivate * source, int source_start, int des
 	if (num_rows == 0) return true;
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(dest_start);
 	if (dest_start + num_rows > rowCount())
 		resizeTo(dest_start + num_rows);
 
@@ -672,6 +684,7 @@ int ColumnPrivate::rowCount() const {
 void ColumnPrivate::resizeTo(int new_size) {
 	int old_size = rowCount();
 	if (new_size == old_size) return;
+	rowsChanged(qMin(old_size, new_size));
 
 	switch(m_column_mode) {
 		case AbstractColumn::Numeric:
@@ -716,6 +729,7 @@ void ColumnPrivate::insertRows(int before, int count) {
 	if (count == 0) return;
 
 	m_formulas.insertRows(before, count);
+	rowsChanged(before);
 
 	if (before <= rowCount()) {
 		switch(m_column_mode) {
@@ -743,6 +757,7 @@ void ColumnPrivate::removeRows(int first, int count) {
 	if (count == 0) return;
 
 	m_formulas.removeRows(first, count);
+	rowsChanged(first);
 
 	if (first < rowCount())
 	{
@@ -973,6 +988,7 @@ void ColumnPrivate::setTextAt(int row, const QString& new_value)
 	if (m_column_mode != AbstractColumn::Text) return;
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(row);
 	if (row >= rowCount())
 		resizeTo(row+1);
 
@@ -991,6 +1007,7 @@ void ColumnPrivate::replaceTexts(int first, const QStringList& new_values)
 	if (m_column_mode != AbstractColumn::Text) return;
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(first);
 	int num_rows = new_values.size();
 	if (first + num_rows > rowCount())
 		resizeTo(first + num_rows);
@@ -1045,6 +1062,7 @@ void ColumnPrivate::setDateTimeAt(int row, const QDateTime& new_value)
 		return;
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(row);
 	if (row >= rowCount())
 		resizeTo(row+1);
 
@@ -1066,6 +1084,7 @@ void ColumnPrivate::replaceDateTimes(int first, const QList<QDateTime>& new_valu
 		return;
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(first);
 	int num_rows = new_values.size();
 	if (first + num_rows > rowCount())
 		resizeTo(first + num_rows);
@@ -1087,6 +1106,7 @@ void ColumnPrivate::setValueAt(int row, double new_value)
 	if (m_column_mode != AbstractColumn::Numeric) return;
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(row);
 	if (row >= rowCount())
 		resizeTo(row+1);
 
@@ -1105,6 +1125,7 @@ void ColumnPrivate::replaceValues(int first, const QVector<double>& new_values)
 	if (m_column_mode != AbstractColumn::Numeric) return;
 
 	emit m_owner->dataAboutToChange(m_owner);
+	rowsChanged(first);
 	int num_rows = new_values.size();
 	if (first + num_rows > rowCount())
 		resizeTo(first + num_rows);
@@ -1121,6 +1142,299 @@ void ColumnPrivate::replaceValues(int first, const QVector<double>& new_values)
 //@}
 ////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+//! \name change tracking
+//@{
+////////////////////////////////////////////////////////////////////////////////
+
+//maximal number of changes kept for firstChangedRow()
+static const int changeHistorySize = 16;
+
+/**
+ * \brief Mark the rows starting at \c first as changed
+ *
+ * Invalidates the min/max pyramid for these rows and records the change for firstChangedRow().
+ * The pyramid is updated on the next request, rows before \c first are not recalculated.
+ * Appending rows therefore only requires the calculation of the new rows.
+ */
+void ColumnPrivate::rowsChanged(int first) {
+	m_minMaxRows = qMin(m_minMaxRows, first);
+	m_sortedRows = qMin(m_sortedRows, first);
+
+	//the changes are kept with increasing first rows, each entry stands for the changes since the previous entry.
+	//A change covers all previous changes starting at the same or at a later row.
+	++m_revision;
+	while (!m_changedRows.isEmpty() && m_changedRows.last() >= first) {
+		m_changedRows.remove(m_changedRows.size() - 1);
+		m_changeRevisions.remove(m_changeRevisions.size() - 1);
+	}
+
+	//combine the two oldest entries if the history is full, the combined entry starts at the first row of the oldest one
+	if (m_changedRows.size() == changeHistorySize) {
+		m_changedRows.remove(1);
+		m_changeRevisions.remove(0);
+	}
+
+	m_changedRows.append(first);
+	m_changeRevisions.append(m_revision);
+}
+
+/**
+ * \brief Return the number of changes of the column so far, see firstChangedRow()
+ */
+quint64 ColumnPrivate::revision() const {
+	return m_revision;
+}
+
+/**
+ * \brief Return the first row changed since the revision \c revision
+ *
+ * Returns rowCount() if the column wasn't changed since then. If the changes since \c revision
+ * were combined with older ones, the returned row may be smaller than the actually first changed row.
+ */
+int ColumnPrivate::firstChangedRow(quint64 revision) const {
+	for (int i = 0; i < m_changeRevisions.size(); ++i) {
+		if (m_changeRevisions.at(i) > revision)
+			return m_changedRows.at(i);
+	}
+
+	return rowCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//@}
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+//! \name min/max pyramid
+//@{
+////////////////////////////////////////////////////////////////////////////////
+
+//rows combined in one entry of the lowest level of the min/max pyramid
+static const int minMaxBlockSize = 64;
+//entries of a level combined in one entry of the next level
+static const int minMaxLevelFactor = 4;
+//the lowest level is calculated in parallel for at least this number of rows
+static const int minParallelMinMaxSize = 1000000;
+
+/*!
+ * calculates the minimum and the maximum of the rows in the blocks from..to-1 of minMaxBlockSize rows,
+ * NaNs are ignored (a block with NaNs only gets min = INFINITY and max = -INFINITY).
+ */
+static void blockMinMax(const double* data, int n, int from, int to, double* min, double* max) {
+	for (int b = from; b < to; ++b) {
+		double bmin = INFINITY;
+		double bmax = -INFINITY;
+		const int end = qMin((b+1)*minMaxBlockSize, n);
+		for (int i = b*minMaxBlockSize; i < end; ++i) {
+			const double value = data[i];
+			if (value < bmin)
+				bmin = value;
+			if (value > bmax)
+				bmax = value;
+		}
+		min[b] = bmin;
+		max[b] = bmax;
+	}
+}
+
+class MinMaxTask : public QRunnable {
+	public:
+		MinMaxTask(const double* data, int n, int from, int to, double* min, double* max) {
+			m_data = data;
+			m_n = n;
+			m_from = from;
+			m_to = to;
+			m_min = min;
+			m_max = max;
+		};
+
+		void run() {
+			blockMinMax(m_data, m_n, m_from, m_to, m_min, m_max);
+		}
+
+	private:
+		const double* m_data;
+		int m_n;
+		int m_from;
+		int m_to;
+		double* m_min;
+		double* m_max;
+};
+
+/**
+ * \brief Update the min/max pyramid of the numeric data
+ *
+ * The lowest level contains the minimum and the maximum of blocks of minMaxBlockSize rows,
+ * every further level combines minMaxLevelFactor entries of the previous one until a level
+ * with one entry is reached. Only the entries of rows changed since the last update are recalculated.
+ */
+void ColumnPrivate::updateMinMax() const {
+	const QVector<double>* vector = static_cast< QVector<double>* >(m_data);
+	const double* data = vector->constData();
+	const int n = vector->size();
+
+	if (m_minMaxData != m_data) {
+		m_minMaxData = m_data;
+		m_minMaxRows = 0;
+		m_sortedRows = 0;
+	}
+	if (m_minMaxRows > n)
+		m_minMaxRows = n;
+	if (m_minMaxRows == n && !m_minLevels.isEmpty())
+		return;
+
+	//extend the range of increasing values
+	int sorted = qMin(m_sortedRows, n);
+	while (sorted < n && !std::isnan(data[sorted]) && (sorted == 0 || data[sorted] >= data[sorted-1]))
+		++sorted;
+	m_sortedRows = sorted;
+
+	int first = m_minMaxRows/minMaxBlockSize;	//first entry to be recalculated
+	int size = (n + minMaxBlockSize - 1)/minMaxBlockSize;
+	int level = 0;
+	int previousSize = 0;
+	do {
+		if (m_minLevels.size() <= level) {
+			m_minLevels.append(QVector<double>());
+			m_maxLevels.append(QVector<double>());
+		}
+		QVector<double>& min = m_minLevels[level];
+		QVector<double>& max = m_maxLevels[level];
+		min.resize(size);
+		max.resize(size);
+
+		if (level == 0) {
+			//many rows are processed in blocks on all available threads
+			QThreadPool* pool = QThreadPool::globalInstance();
+			const int blocks = ((size - first)*minMaxBlockSize < minParallelMinMaxSize) ? 1 : qMax(pool->maxThreadCount(), 1);
+			if (blocks == 1)
+				blockMinMax(data, n, first, size, min.data(), max.data());
+			else {
+				const int range = (size - first + blocks - 1)/blocks;
+				for (int i = 0; i < blocks; ++i) {
+					const int start = first + i*range;
+					const int end = qMin(first + (i+1)*range, size);
+					if (start < end)
+						pool->start(new MinMaxTask(data, n, start, end, min.data(), max.data()));
+				}
+				pool->waitForDone();
+			}
+		} else {
+			const QVector<double>& lowerMin = m_minLevels.at(level-1);
+			const QVector<double>& lowerMax = m_maxLevels.at(level-1);
+			for (int i = first; i < size; ++i) {
+				double bmin = INFINITY;
+				double bmax = -INFINITY;
+				const int end = qMin((i+1)*minMaxLevelFactor, previousSize);
+				for (int j = i*minMaxLevelFactor; j < end; ++j) {
+					if (lowerMin.at(j) < bmin)
+						bmin = lowerMin.at(j);
+					if (lowerMax.at(j) > bmax)
+						bmax = lowerMax.at(j);
+				}
+				min[i] = bmin;
+				max[i] = bmax;
+			}
+		}
+
+		previousSize = size;
+		first /= minMaxLevelFactor;
+		size = (size + minMaxLevelFactor - 1)/minMaxLevelFactor;
+		++level;
+	} while (previousSize > 1);
+
+	m_minLevels.resize(level);
+	m_maxLevels.resize(level);
+	m_minMaxRows = n;
+}
+
+/**
+ * \brief Return the minimum and the maximum of the rows \c first to \c last
+ *
+ * NaNs are ignored, min = INFINITY and max = -INFINITY are returned if there are no values.
+ * For numeric data the values are taken from the min/max pyramid, so that the costs are
+ * logarithmic in the number of rows.
+ */
+void ColumnPrivate::minMax(int first, int last, double& min, double& max) const {
+	min = INFINITY;
+	max = -INFINITY;
+	first = qMax(first, 0);
+	const int end = qMin(last + 1, rowCount());
+
+	if (m_column_mode != AbstractColumn::Numeric) {
+		for (int row = first; row < end; ++row) {
+			const double value = valueAt(row);
+			if (value < min)
+				min = value;
+			if (value > max)
+				max = value;
+		}
+		return;
+	}
+
+	updateMinMax();
+	const double* data = static_cast< QVector<double>* >(m_data)->constData();
+
+	//single rows up to the first and after the last complete block
+	int i = first;
+	int e = end;
+	while (i < e && i%minMaxBlockSize != 0) {
+		if (data[i] < min)
+			min = data[i];
+		if (data[i] > max)
+			max = data[i];
+		++i;
+	}
+	while (e > i && e%minMaxBlockSize != 0) {
+		--e;
+		if (data[e] < min)
+			min = data[e];
+		if (data[e] > max)
+			max = data[e];
+	}
+
+	//complete entries of the levels, going up as soon as the range is aligned to the entries of the next level
+	int a = i/minMaxBlockSize;
+	int b = e/minMaxBlockSize;
+	for (int level = 0; a < b; ++level) {
+		const QVector<double>& levelMin = m_minLevels.at(level);
+		const QVector<double>& levelMax = m_maxLevels.at(level);
+		const bool top = (level == m_minLevels.size() - 1);
+		while (a < b && (top || a%minMaxLevelFactor != 0)) {
+			if (levelMin.at(a) < min)
+				min = levelMin.at(a);
+			if (levelMax.at(a) > max)
+				max = levelMax.at(a);
+			++a;
+		}
+		while (b > a && b%minMaxLevelFactor != 0) {
+			--b;
+			if (levelMin.at(b) < min)
+				min = levelMin.at(b);
+			if (levelMax.at(b) > max)
+				max = levelMax.at(b);
+		}
+		a /= minMaxLevelFactor;
+		b /= minMaxLevelFactor;
+	}
+}
+
+/**
+ * \brief Return \c true if the numeric data doesn't contain NaNs and doesn't decrease
+ */
+bool ColumnPrivate::isMonotonicIncreasing() const {
+	if (m_column_mode != AbstractColumn::Numeric)
+		return false;
+
+	updateMinMax();
+	return (m_sortedRows == rowCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//@}
+////////////////////////////////////////////////////////////////////////////////
+
 /**
  * \brief Return the interval attribute representing the formula strings
  */
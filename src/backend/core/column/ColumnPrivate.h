@@ -92,6 +92,11 @@ class ColumnPrivate: QObject {
 		double valueAt(int row) const;
 		void setValueAt(int row, double new_value);
 		void replaceValues(int first, const QVector<double>& new_values);
+		void minMax(int first, int last, double& min, double& max) const;
+		bool isMonotonicIncreasing() const;
+		void rowsChanged(int first);
+		quint64 revision() const;
+		int firstChangedRow(quint64 revision) const;
 
 		Column::ColumnStatistics statistics;
 		bool statisticsAvailable;
@@ -108,6 +113,16 @@ class ColumnPrivate: QObject {
 		AbstractColumn::PlotDesignation m_plot_designation;
 		int m_width;
 		Column* m_owner;
+
+		void updateMinMax() const;
+		mutable const void* m_minMaxData;	//data the min/max pyramid was calculated for
+		mutable int m_minMaxRows;	//number of rows the min/max pyramid is valid for
+		mutable int m_sortedRows;	//number of leading rows with increasing values
+		mutable QVector< QVector<double> > m_minLevels;	//levels of the min/max pyramid, see updateMinMax()
+		mutable QVector< QVector<double> > m_maxLevels;
+		quint64 m_revision;	//number of changes, see rowsChanged()
+		QVector<int> m_changedRows;	//first rows of the last changes, see rowsChanged()
+		QVector<quint64> m_changeRevisions;	//revisions of the last changes
 };
 
 #endif
@@ -0,0 +1,164 @@
+/***************************************************************************
+    File                 : nsl_fft.c
+    Project              : LabPlot
+    Description          : NSL real FFT with reusable plans
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "nsl_fft.h"
+#include <gsl/gsl_errno.h>
+#ifdef HAVE_FFTW3
+#include <fftw3.h>
+#else
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#endif
+
+struct nsl_fft_plan {
+	size_t n;
+#ifdef HAVE_FFTW3
+	double* buffer;		/* FFTW halfcomplex data r_0, ..., r_n/2, i_(n+1)/2-1, ..., i_1 */
+	fftw_plan forward;
+	fftw_plan backward;
+#else
+	gsl_fft_real_wavetable* real;
+	gsl_fft_halfcomplex_wavetable* hc;
+	gsl_fft_real_workspace* work;
+#endif
+};
+
+nsl_fft_plan* nsl_fft_plan_alloc(size_t n) {
+	if (n == 0)
+		return NULL;
+
+	nsl_fft_plan* plan = (nsl_fft_plan*)malloc(sizeof(nsl_fft_plan));
+	plan->n = n;
+#ifdef HAVE_FFTW3
+	plan->buffer = (double*)fftw_malloc(n*sizeof(double));
+	plan->forward = fftw_plan_r2r_1d(n, plan->buffer, plan->buffer, FFTW_R2HC, FFTW_ESTIMATE);
+	plan->backward = fftw_plan_r2r_1d(n, plan->buffer, plan->buffer, FFTW_HC2R, FFTW_ESTIMATE);
+	if (!plan->buffer || !plan->forward || !plan->backward) {
+#else
+	plan->real = gsl_fft_real_wavetable_alloc(n);
+	plan->hc = gsl_fft_halfcomplex_wavetable_alloc(n);
+	plan->work = gsl_fft_real_workspace_alloc(n);
+	if (!plan->real || !plan->hc || !plan->work) {
+#endif
+		nsl_fft_plan_free(plan);
+		return NULL;
+	}
+
+	return plan;
+}
+
+void nsl_fft_plan_free(nsl_fft_plan* plan) {
+	if (!plan)
+		return;
+#ifdef HAVE_FFTW3
+	if (plan->forward)
+		fftw_destroy_plan(plan->forward);
+	if (plan->backward)
+		fftw_destroy_plan(plan->backward);
+	fftw_free(plan->buffer);
+#else
+	if (plan->real)
+		gsl_fft_real_wavetable_free(plan->real);
+	if (plan->hc)
+		gsl_fft_halfcomplex_wavetable_free(plan->hc);
+	if (plan->work)
+		gsl_fft_real_workspace_free(plan->work);
+#endif
+	free(plan);
+}
+
+size_t nsl_fft_plan_size(const nsl_fft_plan* plan) {
+	return plan->n;
+}
+
+int nsl_fft_real_transform(nsl_fft_plan* plan, double* data) {
+#ifdef HAVE_FFTW3
+	const size_t n = plan->n;
+	size_t k;
+	double* b = plan->buffer;
+	for (k = 0; k < n; k++)
+		b[k] = data[k];
+	fftw_execute(plan->forward);
+
+	/* FFTW to GSL halfcomplex layout */
+	data[0] = b[0];
+	for (k = 1; k < (n+1)/2; k++) {
+		data[2*k-1] = b[k];
+		data[2*k] = b[n-k];
+	}
+	if (n % 2 == 0)
+		data[n-1] = b[n/2];
+
+	return GSL_SUCCESS;
+#else
+	return gsl_fft_real_transform(data, 1, plan->n, plan->real, plan->work);
+#endif
+}
+
+int nsl_fft_halfcomplex_inverse(nsl_fft_plan* plan, double* data) {
+#ifdef HAVE_FFTW3
+	const size_t n = plan->n;
+	size_t k;
+	double* b = plan->buffer;
+
+	/* GSL to FFTW halfcomplex layout */
+	b[0] = data[0];
+	for (k = 1; k < (n+1)/2; k++) {
+		b[k] = data[2*k-1];
+		b[n-k] = data[2*k];
+	}
+	if (n % 2 == 0)
+		b[n/2] = data[n-1];
+	fftw_execute(plan->backward);
+
+	/* FFTW doesn't normalize */
+	for (k = 0; k < n; k++)
+		data[k] = b[k]/n;
+
+	return GSL_SUCCESS;
+#else
+	return gsl_fft_halfcomplex_inverse(data, 1, plan->n, plan->hc, plan->work);
+#endif
+}
+
+size_t nsl_fft_fast_size(size_t n) {
+	size_t size = n;
+	if (n < 2)
+		return n;
+	for (;; size++) {
+		size_t m = size;
+		while (m % 2 == 0)
+			m /= 2;
+		while (m % 3 == 0)
+			m /= 3;
+		while (m % 5 == 0)
+			m /= 5;
+		if (m <= 1)
+			return size;
+	}
+}
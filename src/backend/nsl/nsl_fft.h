@@ -0,0 +1,56 @@
+/***************************************************************************
+    File                 : nsl_fft.h
+    Project              : LabPlot
+    Description          : NSL real FFT with reusable plans
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef NSL_FFT_H
+#define NSL_FFT_H
+
+#include <stdlib.h>
+
+/* Plan for real forward and halfcomplex inverse FFTs of a fixed length n.
+ * The plan keeps the wavetables and the workspace (or the FFTW plans if LabPlot is built with FFTW)
+ * so that transforms of the same length can be repeated without any setup.
+ * The data is always in the halfcomplex layout of gsl_fft_real_transform():
+ *	r_0, r_1, i_1, r_2, i_2, ..., (r_n/2 for even n)
+ */
+typedef struct nsl_fft_plan nsl_fft_plan;
+
+/* allocate a plan for transforms of length n, returns NULL on error */
+nsl_fft_plan* nsl_fft_plan_alloc(size_t n);
+void nsl_fft_plan_free(nsl_fft_plan* plan);
+/* length of the transforms of plan */
+size_t nsl_fft_plan_size(const nsl_fft_plan* plan);
+
+/* in-place forward transform of the n real values in data into halfcomplex format */
+int nsl_fft_real_transform(nsl_fft_plan* plan, double* data);
+/* in-place inverse (normalized) transform of the halfcomplex data */
+int nsl_fft_halfcomplex_inverse(nsl_fft_plan* plan, double* data);
+
+/* smallest length >= n with only the prime factors 2, 3 and 5 (fast FFT) */
+size_t nsl_fft_fast_size(size_t n);
+
+#endif /* NSL_FFT_H */
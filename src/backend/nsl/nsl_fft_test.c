@@ -0,0 +1,57 @@
+/***************************************************************************
+    File                 : nsl_fft_test.c
+    Project              : LabPlot
+    Description          : NSL FFT test
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include "nsl_fft.h"
+
+int main() {
+	const size_t n = 10;
+	double data[10] = {1, 2, 3, 4, 5, 4, 3, 2, 1, 0};
+	size_t i;
+
+	nsl_fft_plan* plan = nsl_fft_plan_alloc(n);
+
+	/* halfcomplex: 25 (-8.472,-6.155) (0,0) (0.472,-1.453) (0,0) 1 */
+	nsl_fft_real_transform(plan, data);
+	for (i = 0; i < n; i++)
+		printf(" %g", data[i]);
+	printf("\n");
+
+	nsl_fft_halfcomplex_inverse(plan, data);
+	for (i = 0; i < n; i++)
+		printf(" %g", data[i]);
+	printf("\n");
+
+	nsl_fft_plan_free(plan);
+
+	/* fast lengths: 1 8 100 1024 1080 */
+	printf("%zu %zu %zu %zu %zu\n", nsl_fft_fast_size(1), nsl_fft_fast_size(7), nsl_fft_fast_size(97),
+		nsl_fft_fast_size(1024), nsl_fft_fast_size(1025));
+
+	return 0;
+}
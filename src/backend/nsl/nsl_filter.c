@@ -0,0 +1,484 @@
+/***************************************************************************
+    File                 : nsl_filter.c
+    Project              : LabPlot
+    Description          : NSL streaming FIR and IIR filters
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "nsl_filter.h"
+#include "nsl_fft.h"
+#include <math.h>
+#include <complex.h>
+#include <string.h>
+#include <gsl/gsl_math.h>
+
+/********* IIR **********/
+
+struct nsl_filter_sos {
+	size_t n;
+	double *b;	/* b0, b1, b2 of each section */
+	double *a;	/* a1, a2 of each section */
+	double *z;	/* state of each section (transposed direct form II) */
+};
+
+/* zeros, poles and gain of a filter */
+typedef struct {
+	double complex *z, *p;
+	size_t nz, np;
+	double k;
+} nsl_filter_zpk;
+
+/* analog low pass prototype with cutoff 1 (epsilon = 1 for Chebyshev) */
+static void nsl_filter_prototype(nsl_filter_form form, unsigned int N, nsl_filter_zpk *f) {
+	unsigned int i;
+	const double mu = asinh(1.)/N;
+	double complex prod_p = 1., prod_z = 1.;
+
+	f->nz = 0;
+	f->np = N;
+	for (i = 0; i < N; i++) {
+		const double theta = M_PI*(2.*i-N+1.)/(2.*N);
+		switch (form) {
+		case nsl_filter_form_butterworth:
+			f->p[i] = -cexp(I*theta);
+			break;
+		case nsl_filter_form_chebyshev_i:
+			f->p[i] = -csinh(mu+I*theta);
+			break;
+		case nsl_filter_form_chebyshev_ii: {
+			const double complex p = -cexp(I*theta);
+			f->p[i] = 1./(sinh(mu)*creal(p) + I*cosh(mu)*cimag(p));
+			if (2*i+1 != N)	/* no zero at infinity */
+				f->z[f->nz++] = -conj(I/sin(theta));
+			break;
+		}
+		case nsl_filter_form_ideal:
+			break;
+		}
+	}
+
+	for (i = 0; i < f->np; i++)
+		prod_p *= -f->p[i];
+	for (i = 0; i < f->nz; i++)
+		prod_z *= -f->z[i];
+
+	switch (form) {
+	case nsl_filter_form_chebyshev_i:
+		f->k = creal(prod_p);
+		if (N % 2 == 0)
+			f->k /= M_SQRT2;
+		break;
+	case nsl_filter_form_chebyshev_ii:
+		f->k = creal(prod_p/prod_z);
+		break;
+	default:
+		f->k = 1.;
+	}
+}
+
+/* real part of prod(c-z)/prod(c-p) */
+static double nsl_filter_zpk_ratio(const nsl_filter_zpk *f, double c) {
+	size_t i;
+	double complex r = 1.;
+	for (i = 0; i < f->nz; i++)
+		r *= c-f->z[i];
+	for (i = 0; i < f->np; i++)
+		r /= c-f->p[i];
+	return creal(r);
+}
+
+/* transformations of the prototype (cutoff wo, band width bw) */
+static void nsl_filter_lp2lp(nsl_filter_zpk *f, double wo) {
+	size_t i;
+	for (i = 0; i < f->nz; i++)
+		f->z[i] *= wo;
+	for (i = 0; i < f->np; i++)
+		f->p[i] *= wo;
+	f->k *= pow(wo, (double)(f->np-f->nz));
+}
+
+static void nsl_filter_lp2hp(nsl_filter_zpk *f, double wo) {
+	size_t i;
+	const size_t degree = f->np-f->nz;
+	f->k *= nsl_filter_zpk_ratio(f, 0);
+	for (i = 0; i < f->nz; i++)
+		f->z[i] = wo/f->z[i];
+	for (i = 0; i < f->np; i++)
+		f->p[i] = wo/f->p[i];
+	for (i = 0; i < degree; i++)
+		f->z[f->nz++] = 0;
+}
+
+static void nsl_filter_lp2bp(nsl_filter_zpk *f, double wo, double bw) {
+	size_t i;
+	const size_t degree = f->np-f->nz, nz = f->nz, np = f->np;
+	for (i = 0; i < nz; i++) {
+		const double complex z = f->z[i]*bw/2., root = csqrt(z*z-wo*wo);
+		f->z[i] = z+root;
+		f->z[nz+i] = z-root;
+	}
+	for (i = 0; i < np; i++) {
+		const double complex p = f->p[i]*bw/2., root = csqrt(p*p-wo*wo);
+		f->p[i] = p+root;
+		f->p[np+i] = p-root;
+	}
+	f->nz = 2*nz;
+	f->np = 2*np;
+	for (i = 0; i < degree; i++)
+		f->z[f->nz++] = 0;
+	f->k *= pow(bw, (double)degree);
+}
+
+static void nsl_filter_lp2bs(nsl_filter_zpk *f, double wo, double bw) {
+	size_t i;
+	const size_t degree = f->np-f->nz, nz = f->nz, np = f->np;
+	f->k *= nsl_filter_zpk_ratio(f, 0);
+	for (i = 0; i < nz; i++) {
+		const double complex z = bw/2./f->z[i], root = csqrt(z*z-wo*wo);
+		f->z[i] = z+root;
+		f->z[nz+i] = z-root;
+	}
+	for (i = 0; i < np; i++) {
+		const double complex p = bw/2./f->p[i], root = csqrt(p*p-wo*wo);
+		f->p[i] = p+root;
+		f->p[np+i] = p-root;
+	}
+	f->nz = 2*nz;
+	f->np = 2*np;
+	for (i = 0; i < degree; i++) {
+		f->z[f->nz++] = I*wo;
+		f->z[f->nz++] = -I*wo;
+	}
+}
+
+/* bilinear transform s = 2(z-1)/(z+1) (sample rate 1) */
+static void nsl_filter_bilinear(nsl_filter_zpk *f) {
+	size_t i;
+	const size_t degree = f->np-f->nz;
+	f->k *= nsl_filter_zpk_ratio(f, 2.);
+	for (i = 0; i < f->nz; i++)
+		f->z[i] = (2.+f->z[i])/(2.-f->z[i]);
+	for (i = 0; i < f->np; i++)
+		f->p[i] = (2.+f->p[i])/(2.-f->p[i]);
+	for (i = 0; i < degree; i++)
+		f->z[f->nz++] = -1.;
+}
+
+/* quadratic factors 1 + c[1] x^-1 + c[2] x^-2 of the polynomial with the given (real or complex conjugate) roots.
+ * Returns the number of factors, the root of each factor with the largest imaginary part is stored in repr. */
+static size_t nsl_filter_quadratics(const double complex *roots, size_t n, double *c, double complex *repr) {
+	size_t i, count = 0;
+	int single = -1;	/* real root without partner yet */
+
+	for (i = 0; i < n; i++) {
+		const double complex r = roots[i];
+		if (fabs(cimag(r)) > 1.e-10*(1.+cabs(r))) {
+			if (cimag(r) > 0) {	/* complex conjugate pair */
+				c[2*count] = -2.*creal(r);
+				c[2*count+1] = creal(r)*creal(r)+cimag(r)*cimag(r);
+				repr[count++] = r;
+			}
+		} else if (single < 0)
+			single = i;
+		else {
+			const double r1 = creal(roots[single]), r2 = creal(r);
+			c[2*count] = -(r1+r2);
+			c[2*count+1] = r1*r2;
+			repr[count++] = r1;
+			single = -1;
+		}
+	}
+	if (single >= 0) {	/* first order factor */
+		c[2*count] = -creal(roots[single]);
+		c[2*count+1] = 0;
+		repr[count++] = creal(roots[single]);
+	}
+
+	return count;
+}
+
+nsl_filter_sos* nsl_filter_sos_design(nsl_filter_type type, nsl_filter_form form, unsigned int order, double f1, double f2) {
+	size_t i, j;
+	const int band = (type == nsl_filter_type_band_pass || type == nsl_filter_type_band_reject);
+	if (form == nsl_filter_form_ideal || order < 1 || f1 <= 0 || f1 >= 0.5 || (band && (f2 <= f1 || f2 >= 0.5)))
+		return NULL;
+
+	/* zeros and poles of the filter */
+	nsl_filter_zpk f;
+	f.z = (double complex *)malloc(2*order*sizeof(double complex));
+	f.p = (double complex *)malloc(2*order*sizeof(double complex));
+	nsl_filter_prototype(form, order, &f);
+
+	/* prewarped analog frequencies */
+	const double w1 = 2.*tan(M_PI*f1), w2 = band ? 2.*tan(M_PI*f2) : 0;
+	switch (type) {
+	case nsl_filter_type_low_pass:
+		nsl_filter_lp2lp(&f, w1);
+		break;
+	case nsl_filter_type_high_pass:
+		nsl_filter_lp2hp(&f, w1);
+		break;
+	case nsl_filter_type_band_pass:
+		nsl_filter_lp2bp(&f, sqrt(w1*w2), w2-w1);
+		break;
+	case nsl_filter_type_band_reject:
+		nsl_filter_lp2bs(&f, sqrt(w1*w2), w2-w1);
+		break;
+	}
+	nsl_filter_bilinear(&f);
+
+	/* second order sections */
+	double *zc = (double *)malloc((f.nz+1)*sizeof(double)), *pc = (double *)malloc((f.np+1)*sizeof(double));
+	double complex *zr = (double complex *)malloc(f.nz*sizeof(double complex)), *pr = (double complex *)malloc(f.np*sizeof(double complex));
+	const size_t nzq = nsl_filter_quadratics(f.z, f.nz, zc, zr);
+	const size_t n = nsl_filter_quadratics(f.p, f.np, pc, pr);
+
+	nsl_filter_sos *sos = (nsl_filter_sos *)malloc(sizeof(nsl_filter_sos));
+	sos->n = n;
+	sos->b = (double *)malloc(3*n*sizeof(double));
+	sos->a = (double *)malloc(2*n*sizeof(double));
+	sos->z = (double *)calloc(2*n, sizeof(double));
+
+	/* pair each pole factor with the nearest remaining zero factor */
+	int *used = (int *)calloc(nzq+1, sizeof(int));
+	for (i = 0; i < n; i++) {
+		size_t best = nzq;
+		for (j = 0; j < nzq; j++)
+			if (!used[j] && (best == nzq || cabs(zr[j]-pr[i]) < cabs(zr[best]-pr[i])))
+				best = j;
+
+		sos->a[2*i] = pc[2*i];
+		sos->a[2*i+1] = pc[2*i+1];
+		sos->b[3*i] = 1.;
+		if (best < nzq) {
+			used[best] = 1;
+			sos->b[3*i+1] = zc[2*best];
+			sos->b[3*i+2] = zc[2*best+1];
+		} else {
+			sos->b[3*i+1] = 0;
+			sos->b[3*i+2] = 0;
+		}
+	}
+	/* overall gain */
+	for (j = 0; j < 3; j++)
+		sos->b[j] *= f.k;
+
+	free(used);
+	free(zc);
+	free(pc);
+	free(zr);
+	free(pr);
+	free(f.z);
+	free(f.p);
+
+	return sos;
+}
+
+void nsl_filter_sos_free(nsl_filter_sos* sos) {
+	if (!sos)
+		return;
+	free(sos->b);
+	free(sos->a);
+	free(sos->z);
+	free(sos);
+}
+
+size_t nsl_filter_sos_size(const nsl_filter_sos* sos) {
+	return sos->n;
+}
+
+void nsl_filter_sos_coefficients(const nsl_filter_sos* sos, size_t i, double* b, double* a) {
+	memcpy(b, sos->b+3*i, 3*sizeof(double));
+	memcpy(a, sos->a+2*i, 2*sizeof(double));
+}
+
+void nsl_filter_sos_process(nsl_filter_sos* sos, double* data, size_t n) {
+	size_t i, k;
+	for (i = 0; i < sos->n; i++) {
+		const double b0 = sos->b[3*i], b1 = sos->b[3*i+1], b2 = sos->b[3*i+2];
+		const double a1 = sos->a[2*i], a2 = sos->a[2*i+1];
+		double z1 = sos->z[2*i], z2 = sos->z[2*i+1];
+		for (k = 0; k < n; k++) {
+			const double x = data[k], y = b0*x + z1;
+			z1 = b1*x - a1*y + z2;
+			z2 = b2*x - a2*y;
+			data[k] = y;
+		}
+		sos->z[2*i] = z1;
+		sos->z[2*i+1] = z2;
+	}
+}
+
+void nsl_filter_sos_reset(nsl_filter_sos* sos) {
+	memset(sos->z, 0, 2*sos->n*sizeof(double));
+}
+
+/********* FIR **********/
+
+struct nsl_filter_fir {
+	size_t taps;
+	size_t L, M;	/* FFT length and number of results per block */
+	double *H;	/* transform of h */
+	double *u;	/* block: taps-1 previous and M new input values */
+	double *w;	/* work space */
+	size_t count;	/* number of new input values in the block */
+	nsl_fft_plan *plan;
+};
+
+/* low pass with cutoff f normalized to unit gain at f=0 */
+static void nsl_filter_fir_low_pass(double f, double* h, size_t taps) {
+	size_t j;
+	const double c = (taps-1)/2.;
+	double sum = 0;
+	for (j = 0; j < taps; j++) {
+		const double x = j-c;
+		h[j] = (x == 0) ? 2.*f : sin(2.*M_PI*f*x)/(M_PI*x);
+		if (taps > 1)
+			h[j] *= 0.54-0.46*cos(2.*M_PI*j/(taps-1));
+		sum += h[j];
+	}
+	for (j = 0; j < taps; j++)
+		h[j] /= sum;
+}
+
+int nsl_filter_fir_ideal(nsl_filter_type type, double f1, double f2, double* h, size_t taps) {
+	size_t j;
+	const int band = (type == nsl_filter_type_band_pass || type == nsl_filter_type_band_reject);
+	if (taps % 2 == 0 || f1 <= 0 || f1 >= 0.5 || (band && (f2 <= f1 || f2 >= 0.5)))
+		return -1;
+
+	nsl_filter_fir_low_pass(f1, h, taps);
+	if (band) {	/* band pass = low pass(f2) - low pass(f1) */
+		double *h2 = (double *)malloc(taps*sizeof(double));
+		nsl_filter_fir_low_pass(f2, h2, taps);
+		for (j = 0; j < taps; j++)
+			h[j] = h2[j]-h[j];
+		free(h2);
+	}
+	if (type == nsl_filter_type_high_pass || type == nsl_filter_type_band_reject) {	/* spectral inversion */
+		for (j = 0; j < taps; j++)
+			h[j] = -h[j];
+		h[(taps-1)/2] += 1.;
+	}
+
+	return 0;
+}
+
+nsl_filter_fir* nsl_filter_fir_alloc(const double* h, size_t taps) {
+	size_t L = 64;
+	if (taps == 0)
+		return NULL;
+	while (L < 4*taps)
+		L *= 2;
+
+	nsl_filter_fir *fir = (nsl_filter_fir *)malloc(sizeof(nsl_filter_fir));
+	fir->taps = taps;
+	fir->L = L;
+	fir->M = L-taps+1;
+	fir->count = 0;
+	fir->plan = nsl_fft_plan_alloc(L);
+	fir->H = (double *)calloc(L, sizeof(double));
+	fir->u = (double *)calloc(L, sizeof(double));
+	fir->w = (double *)malloc(L*sizeof(double));
+	if (!fir->plan) {
+		nsl_filter_fir_free(fir);
+		return NULL;
+	}
+
+	memcpy(fir->H, h, taps*sizeof(double));
+	nsl_fft_real_transform(fir->plan, fir->H);
+
+	return fir;
+}
+
+void nsl_filter_fir_free(nsl_filter_fir* fir) {
+	if (!fir)
+		return;
+	nsl_fft_plan_free(fir->plan);
+	free(fir->H);
+	free(fir->u);
+	free(fir->w);
+	free(fir);
+}
+
+/* convolve the block and write the results of the first count new values to y */
+static void nsl_filter_fir_block(nsl_filter_fir* fir, size_t count, double* y) {
+	size_t k;
+	const size_t L = fir->L;
+	double *w = fir->w;
+	const double *H = fir->H;
+
+	memcpy(w, fir->u, (fir->taps-1+count)*sizeof(double));
+	for (k = fir->taps-1+count; k < L; k++)
+		w[k] = 0;
+	nsl_fft_real_transform(fir->plan, w);
+
+	/* multiply halfcomplex arrays */
+	w[0] *= H[0];
+	for (k = 1; k < (L+1)/2; k++) {
+		const double re = w[2*k-1]*H[2*k-1]-w[2*k]*H[2*k];
+		const double im = w[2*k-1]*H[2*k]+w[2*k]*H[2*k-1];
+		w[2*k-1] = re;
+		w[2*k] = im;
+	}
+	if (L % 2 == 0)
+		w[L-1] *= H[L-1];
+
+	nsl_fft_halfcomplex_inverse(fir->plan, w);
+	memcpy(y, w+fir->taps-1, count*sizeof(double));
+}
+
+size_t nsl_filter_fir_process(nsl_filter_fir* fir, const double* x, size_t n, double* y) {
+	size_t i, results = 0;
+	const size_t history = fir->taps-1;
+
+	for (i = 0; i < n; i++) {
+		fir->u[history + fir->count++] = x[i];
+		if (fir->count == fir->M) {
+			nsl_filter_fir_block(fir, fir->M, y+results);
+			results += fir->M;
+			/* keep the last taps-1 values as history */
+			memmove(fir->u, fir->u+fir->M, history*sizeof(double));
+			fir->count = 0;
+		}
+	}
+
+	return results;
+}
+
+size_t nsl_filter_fir_pending(const nsl_filter_fir* fir) {
+	return fir->count;
+}
+
+size_t nsl_filter_fir_flush(nsl_filter_fir* fir, double* y) {
+	const size_t count = fir->count;
+	if (count > 0)
+		nsl_filter_fir_block(fir, count, y);
+
+	/* start a new signal */
+	memset(fir->u, 0, fir->L*sizeof(double));
+	fir->count = 0;
+
+	return count;
+}
@@ -0,0 +1,80 @@
+/***************************************************************************
+    File                 : nsl_filter.h
+    Project              : LabPlot
+    Description          : NSL streaming FIR and IIR filters
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef NSL_FILTER_H
+#define NSL_FILTER_H
+
+#include <stdlib.h>
+
+/* filter types and forms (same order as XYFourierFilterCurve::FilterType and FilterForm) */
+typedef enum {nsl_filter_type_low_pass, nsl_filter_type_high_pass, nsl_filter_type_band_pass,
+	nsl_filter_type_band_reject} nsl_filter_type;
+typedef enum {nsl_filter_form_ideal, nsl_filter_form_butterworth, nsl_filter_form_chebyshev_i,
+	nsl_filter_form_chebyshev_ii} nsl_filter_form;
+
+/* All filters are causal and keep their state between calls, so a signal can be processed
+ * chunk by chunk with bounded memory, giving the same result as processing it at once.
+ * Frequencies are given in units of the sample rate (0 < f < 0.5), f2 is only used for band filters.
+ */
+
+/********* IIR: cascade of second order sections (biquads) **********/
+
+typedef struct nsl_filter_sos nsl_filter_sos;
+
+/* Design a Butterworth or Chebyshev (type I or II, 3 dB ripple at the cutoff like the Fourier filter)
+ * filter of the given order via the bilinear transform. Returns NULL for invalid parameters. */
+nsl_filter_sos* nsl_filter_sos_design(nsl_filter_type type, nsl_filter_form form, unsigned int order, double f1, double f2);
+void nsl_filter_sos_free(nsl_filter_sos* sos);
+/* number of sections */
+size_t nsl_filter_sos_size(const nsl_filter_sos* sos);
+/* coefficients of section i: b0, b1, b2 and a1, a2 (a0 = 1) */
+void nsl_filter_sos_coefficients(const nsl_filter_sos* sos, size_t i, double* b, double* a);
+/* filter the n values in data in place */
+void nsl_filter_sos_process(nsl_filter_sos* sos, double* data, size_t n);
+/* clear the state (start of a new signal) */
+void nsl_filter_sos_reset(nsl_filter_sos* sos);
+
+/********* FIR: overlap-save FFT convolution **********/
+
+typedef struct nsl_filter_fir nsl_filter_fir;
+
+/* windowed-sinc (Hamming) approximation of the ideal filter with taps (odd) coefficients in h */
+int nsl_filter_fir_ideal(nsl_filter_type type, double f1, double f2, double* h, size_t taps);
+
+/* filter with the impulse response h[0..taps-1]: y[k] = h[0]*x[k] + ... + h[taps-1]*x[k-taps+1] */
+nsl_filter_fir* nsl_filter_fir_alloc(const double* h, size_t taps);
+void nsl_filter_fir_free(nsl_filter_fir* fir);
+/* Filter the n values in x. The results are written block-wise to y (which needs room for
+ * n + nsl_filter_fir_pending() values), returns the number of written results. */
+size_t nsl_filter_fir_process(nsl_filter_fir* fir, const double* x, size_t n, double* y);
+/* number of input values without result yet */
+size_t nsl_filter_fir_pending(const nsl_filter_fir* fir);
+/* write the results of the pending input values to y and return their number. The next input starts a new signal */
+size_t nsl_filter_fir_flush(nsl_filter_fir* fir, double* y);
+
+#endif /* NSL_FILTER_H */
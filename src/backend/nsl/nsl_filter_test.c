@@ -0,0 +1,78 @@
+/***************************************************************************
+    File                 : nsl_filter_test.c
+    Project              : LabPlot
+    Description          : NSL filter test
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include "nsl_filter.h"
+
+int main() {
+	size_t i, j;
+	double b[3], a[2];
+
+	/* Butterworth low pass, order 2, f=0.1: b = 0.0675 0.1349 0.0675, a = 1 -1.143 0.4128 */
+	nsl_filter_sos* sos = nsl_filter_sos_design(nsl_filter_type_low_pass, nsl_filter_form_butterworth, 2, 0.1, 0);
+	for (i = 0; i < nsl_filter_sos_size(sos); i++) {
+		nsl_filter_sos_coefficients(sos, i, b, a);
+		printf("b = %g %g %g, a = 1 %g %g\n", b[0], b[1], b[2], a[0], a[1]);
+	}
+
+	/* step response, processed in two chunks */
+	double data[10] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+	nsl_filter_sos_process(sos, data, 4);
+	nsl_filter_sos_process(sos, data+4, 6);
+	for (i = 0; i < 10; i++)
+		printf(" %g", data[i]);
+	printf("\n");
+	nsl_filter_sos_free(sos);
+
+	/* Chebyshev type I band pass, order 3: 6 poles in 3 sections */
+	sos = nsl_filter_sos_design(nsl_filter_type_band_pass, nsl_filter_form_chebyshev_i, 3, 0.1, 0.2);
+	printf("sections: %zu\n", nsl_filter_sos_size(sos));
+	nsl_filter_sos_free(sos);
+
+	/* FIR: moving sum of 3 values, streamed in chunks of 4 values */
+	double h[3] = {1, 1, 1}, x[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, y[20];
+	nsl_filter_fir* fir = nsl_filter_fir_alloc(h, 3);
+	size_t count = 0;
+	for (j = 0; j < 10; j += 4)
+		count += nsl_filter_fir_process(fir, x+j, (j+4 < 10) ? 4 : 10-j, y+count);
+	count += nsl_filter_fir_flush(fir, y+count);
+	/* 1 3 6 9 12 15 18 21 24 27 */
+	for (i = 0; i < count; i++)
+		printf(" %g", y[i]);
+	printf("\n");
+	nsl_filter_fir_free(fir);
+
+	/* windowed-sinc low pass (unit gain at f=0) */
+	double hl[11], sum = 0;
+	nsl_filter_fir_ideal(nsl_filter_type_low_pass, 0.2, 0, hl, 11);
+	for (i = 0; i < 11; i++)
+		sum += hl[i];
+	printf("sum = %g\n", sum);
+
+	return 0;
+}
@@ -0,0 +1,715 @@
+/***************************************************************************
+    File                 : nsl_fit.c
+    Project              : LabPlot
+    Description          : NSL fit models
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <math.h>
+#include <float.h>
+#include "nsl_fit.h"
+
+/* helper */
+
+static void nsl_fit_range(const double* x, size_t n, double* min, double* max) {
+	size_t i;
+	*min = *max = x[0];
+	for (i = 1; i < n; i++) {
+		if (x[i] < *min)
+			*min = x[i];
+		if (x[i] > *max)
+			*max = x[i];
+	}
+}
+
+static size_t nsl_fit_argmax(const double* y, size_t n) {
+	size_t i, imax = 0;
+	for (i = 1; i < n; i++)
+		if (y[i] > y[imax])
+			imax = i;
+	return imax;
+}
+
+/* half width of the peak at index i in (x,y) where y drops below level (data sorted by x), 0 if not found */
+static double nsl_fit_peak_halfwidth(const double* x, const double* y, size_t n, size_t i, double level) {
+	size_t l = i, r = i;
+	while (l > 0 && y[l] > level)
+		l--;
+	while (r < n-1 && y[r] > level)
+		r++;
+	if (l == r)
+		return 0;
+	return fabs(x[r]-x[l])/2.;
+}
+
+int nsl_fit_linear(const double* x, const double* y, const double* w, size_t n, double* a, double* b) {
+	double sw = 0, sx = 0, sy = 0, sxx = 0, sxy = 0, det;
+	size_t i, count = 0;
+	for (i = 0; i < n; i++) {
+		double wi = w ? w[i] : 1.0;
+		if (wi <= 0)
+			continue;
+		sw += wi;
+		sx += wi*x[i];
+		sy += wi*y[i];
+		sxx += wi*x[i]*x[i];
+		sxy += wi*x[i]*y[i];
+		count++;
+	}
+	if (count < 2)
+		return 1;
+
+	det = sw*sxx - sx*sx;
+	if (det == 0)
+		return 1;
+
+	*b = (sw*sxy - sx*sy)/det;
+	*a = (sy - *b*sx)/sw;
+	return 0;
+}
+
+/* log-linear regression ln|y| = ln|a| + b*t of the points with the sign of the majority of y. weights y^2 compensate the transformation */
+static int nsl_fit_loglinear(const double* t, const double* y, size_t n, double* a, double* b) {
+	double* ly = (double*)malloc(n*sizeof(double));
+	double* w = (double*)malloc(n*sizeof(double));
+	double sum = 0, sign, la;
+	size_t i;
+	int status;
+
+	for (i = 0; i < n; i++)
+		sum += y[i];
+	sign = (sum < 0) ? -1.0 : 1.0;
+
+	for (i = 0; i < n; i++) {
+		if (sign*y[i] > 0 && !isnan(t[i]) && !isinf(t[i])) {
+			ly[i] = log(sign*y[i]);
+			w[i] = y[i]*y[i];
+		} else {
+			ly[i] = 0;
+			w[i] = 0;
+		}
+	}
+
+	status = nsl_fit_linear(t, ly, w, n, &la, b);
+	if (status == 0)
+		*a = sign*exp(la);
+
+	free(ly);
+	free(w);
+	return status;
+}
+
+/* Polynomial: c0 + c1*x + ... + cn*x^n */
+
+static size_t nsl_fit_polynomial_nparams(unsigned int degree) {
+	return degree + 1;
+}
+
+static void nsl_fit_polynomial_f(const double* x, size_t n, const double* p, unsigned int degree, double* y) {
+	size_t i;
+	int j;
+	for (i = 0; i < n; i++) {
+		double v = p[degree];
+		for (j = (int)degree - 1; j >= 0; j--)
+			v = v*x[i] + p[j];
+		y[i] = v;
+	}
+}
+
+static void nsl_fit_polynomial_df(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda) {
+	size_t i, j;
+	(void)p;
+	for (i = 0; i < n; i++) {
+		double* row = J + i*tda;
+		row[0] = 1.0;
+		for (j = 1; j <= degree; j++)
+			row[j] = row[j-1]*x[i];
+	}
+}
+
+/* linear least squares (the polynomial model is linear in the parameters) on x scaled to [-1,1] */
+static int nsl_fit_polynomial_guess(const double* x, const double* y, size_t n, unsigned int degree, double* p) {
+	const size_t np = degree + 1;
+	double* A = (double*)calloc(np*(np+1), sizeof(double));	/* augmented matrix of the normal equations */
+	double* t = (double*)malloc(np*sizeof(double));
+	double min, max, scale;
+	size_t i, j, k;
+	int status = 0;
+
+	if (n < np) {
+		free(A);
+		free(t);
+		return 1;
+	}
+
+	nsl_fit_range(x, n, &min, &max);
+	scale = fmax(fabs(min), fabs(max));
+	if (scale == 0)
+		scale = 1.0;
+
+	for (i = 0; i < n; i++) {
+		t[0] = 1.0;
+		for (j = 1; j < np; j++)
+			t[j] = t[j-1]*x[i]/scale;
+		for (j = 0; j < np; j++) {
+			for (k = 0; k < np; k++)
+				A[j*(np+1)+k] += t[j]*t[k];
+			A[j*(np+1)+np] += t[j]*y[i];
+		}
+	}
+
+	/* Gaussian elimination with partial pivoting */
+	for (j = 0; j < np && status == 0; j++) {
+		size_t pivot = j;
+		for (i = j+1; i < np; i++)
+			if (fabs(A[i*(np+1)+j]) > fabs(A[pivot*(np+1)+j]))
+				pivot = i;
+		if (A[pivot*(np+1)+j] == 0) {
+			status = 1;
+			break;
+		}
+		if (pivot != j) {
+			for (k = 0; k <= np; k++) {
+				double tmp = A[j*(np+1)+k];
+				A[j*(np+1)+k] = A[pivot*(np+1)+k];
+				A[pivot*(np+1)+k] = tmp;
+			}
+		}
+		for (i = j+1; i < np; i++) {
+			double factor = A[i*(np+1)+j]/A[j*(np+1)+j];
+			for (k = j; k <= np; k++)
+				A[i*(np+1)+k] -= factor*A[j*(np+1)+k];
+		}
+	}
+
+	if (status == 0) {
+		for (j = np; j-- > 0; ) {
+			double v = A[j*(np+1)+np];
+			for (k = j+1; k < np; k++)
+				v -= A[j*(np+1)+k]*p[k];
+			p[j] = v/A[j*(np+1)+j];
+		}
+		/* undo the scaling of x */
+		for (j = 1; j < np; j++)
+			p[j] /= pow(scale, j);
+	}
+
+	free(A);
+	free(t);
+	return status;
+}
+
+/* Power: a*x^b (degree 1) or a + b*x^c (degree 2) */
+
+static size_t nsl_fit_power_nparams(unsigned int degree) {
+	return (degree == 1) ? 2 : 3;
+}
+
+static void nsl_fit_power_f(const double* x, size_t n, const double* p, unsigned int degree, double* y) {
+	size_t i;
+	if (degree == 1) {
+		for (i = 0; i < n; i++)
+			y[i] = p[0]*pow(x[i], p[1]);
+	} else {
+		for (i = 0; i < n; i++)
+			y[i] = p[0] + p[1]*pow(x[i], p[2]);
+	}
+}
+
+static void nsl_fit_power_df(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda) {
+	size_t i;
+	if (degree == 1) {
+		for (i = 0; i < n; i++) {
+			const double v = pow(x[i], p[1]);
+			J[i*tda] = v;
+			J[i*tda+1] = p[0]*v*log(x[i]);
+		}
+	} else {
+		for (i = 0; i < n; i++) {
+			const double v = pow(x[i], p[2]);
+			J[i*tda] = 1.0;
+			J[i*tda+1] = v;
+			J[i*tda+2] = p[1]*v*log(x[i]);
+		}
+	}
+}
+
+/* log-linear regression ln(y) = ln(a) + b*ln(x) */
+static int nsl_fit_power_guess(const double* x, const double* y, size_t n, unsigned int degree, double* p) {
+	double* lx = (double*)malloc(n*sizeof(double));
+	double a, b;
+	size_t i;
+	int status;
+
+	for (i = 0; i < n; i++)
+		lx[i] = (x[i] > 0) ? log(x[i]) : NAN;
+	status = nsl_fit_loglinear(lx, y, n, &a, &b);
+	free(lx);
+	if (status)
+		return status;
+
+	if (degree == 1) {
+		p[0] = a;
+		p[1] = b;
+	} else {
+		p[0] = 0;
+		p[1] = a;
+		p[2] = b;
+	}
+	return 0;
+}
+
+/* Exponential: a*exp(b*x) + c*exp(d*x) + ... */
+
+static size_t nsl_fit_exponential_nparams(unsigned int degree) {
+	return 2*degree;
+}
+
+static void nsl_fit_exponential_f(const double* x, size_t n, const double* p, unsigned int degree, double* y) {
+	size_t i, j;
+	for (i = 0; i < n; i++) {
+		double v = 0;
+		for (j = 0; j < degree; j++)
+			v += p[2*j]*exp(p[2*j+1]*x[i]);
+		y[i] = v;
+	}
+}
+
+static void nsl_fit_exponential_df(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda) {
+	size_t i, j;
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < degree; j++) {
+			const double e = exp(p[2*j+1]*x[i]);
+			J[i*tda+2*j] = e;
+			J[i*tda+2*j+1] = p[2*j]*x[i]*e;
+		}
+	}
+}
+
+/* log-linear regression ln(y) = ln(a) + b*x, additional terms share the amplitude and have rates spread around b */
+static int nsl_fit_exponential_guess(const double* x, const double* y, size_t n, unsigned int degree, double* p) {
+	double a, b;
+	size_t j;
+	int status = nsl_fit_loglinear(x, y, n, &a, &b);
+	if (status)
+		return status;
+
+	for (j = 0; j < degree; j++) {
+		p[2*j] = a/degree;
+		p[2*j+1] = b*(1.0 + 0.5*(j - (degree-1)/2.));
+	}
+	return 0;
+}
+
+/* Inverse exponential: a*(1-exp(b*x)) + c */
+
+static size_t nsl_fit_inverse_exponential_nparams(unsigned int degree) {
+	(void)degree;
+	return 3;
+}
+
+static void nsl_fit_inverse_exponential_f(const double* x, size_t n, const double* p, unsigned int degree, double* y) {
+	size_t i;
+	(void)degree;
+	for (i = 0; i < n; i++)
+		y[i] = p[0]*(1.0 - exp(p[1]*x[i])) + p[2];
+}
+
+static void nsl_fit_inverse_exponential_df(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda) {
+	size_t i;
+	(void)degree;
+	for (i = 0; i < n; i++) {
+		const double e = exp(p[1]*x[i]);
+		J[i*tda] = 1.0 - e;
+		J[i*tda+1] = -p[0]*x[i]*e;
+		J[i*tda+2] = 1.0;
+	}
+}
+
+/* saturation within the data range is assumed (b = -3/range), a and c follow from a linear regression */
+static int nsl_fit_inverse_exponential_guess(const double* x, const double* y, size_t n, unsigned int degree, double* p) {
+	double* t = (double*)malloc(n*sizeof(double));
+	double min, max, a, c;
+	size_t i;
+	int status;
+	(void)degree;
+
+	nsl_fit_range(x, n, &min, &max);
+	if (max == min) {
+		free(t);
+		return 1;
+	}
+
+	p[1] = -3./(max - min);
+	for (i = 0; i < n; i++)
+		t[i] = 1.0 - exp(p[1]*x[i]);
+	status = nsl_fit_linear(t, y, NULL, n, &c, &a);
+	free(t);
+	if (status)
+		return status;
+
+	p[0] = a;
+	p[2] = c;
+	return 0;
+}
+
+/* Fourier: a0 + (a1*cos(w*x) + b1*sin(w*x)) + ... + (an*cos(n*w*x) + bn*sin(n*w*x)), parameters w, a0, a1, b1, ... an, bn */
+
+static size_t nsl_fit_fourier_nparams(unsigned int degree) {
+	return 2*degree + 2;
+}
+
+static void nsl_fit_fourier_f(const double* x, size_t n, const double* p, unsigned int degree, double* y) {
+	size_t i, j;
+	const double w = p[0];
+	for (i = 0; i < n; i++) {
+		double v = p[1];
+		for (j = 1; j <= degree; j++)
+			v += p[2*j]*cos(j*w*x[i]) + p[2*j+1]*sin(j*w*x[i]);
+		y[i] = v;
+	}
+}
+
+static void nsl_fit_fourier_df(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda) {
+	size_t i, j;
+	const double w = p[0];
+	for (i = 0; i < n; i++) {
+		double* row = J + i*tda;
+		double wd = 0;	/* derivative with respect to w */
+		row[1] = 1.0;
+		for (j = 1; j <= degree; j++) {
+			const double c = cos(j*w*x[i]), s = sin(j*w*x[i]);
+			wd += j*x[i]*(-p[2*j]*s + p[2*j+1]*c);
+			row[2*j] = c;
+			row[2*j+1] = s;
+		}
+		row[0] = wd;
+	}
+}
+
+/* base frequency from the data range, coefficients from the projections onto the harmonics */
+static int nsl_fit_fourier_guess(const double* x, const double* y, size_t n, unsigned int degree, double* p) {
+	double min, max, mean = 0;
+	size_t i, j;
+
+	nsl_fit_range(x, n, &min, &max);
+	if (max == min)
+		return 1;
+
+	p[0] = 2.*M_PI/(max - min);
+	for (i = 0; i < n; i++)
+		mean += y[i];
+	p[1] = mean/n;
+
+	for (j = 1; j <= degree; j++) {
+		double a = 0, b = 0;
+		for (i = 0; i < n; i++) {
+			a += (y[i] - p[1])*cos(j*p[0]*x[i]);
+			b += (y[i] - p[1])*sin(j*p[0]*x[i]);
+		}
+		p[2*j] = 2.*a/n;
+		p[2*j+1] = 2.*b/n;
+	}
+	return 0;
+}
+
+/* Gaussian: a1*exp(-((x-b1)/c1)^2) + ... + an*exp(-((x-bn)/cn)^2) */
+
+static size_t nsl_fit_gaussian_nparams(unsigned int degree) {
+	return 3*degree;
+}
+
+static void nsl_fit_gaussian_f(const double* x, size_t n, const double* p, unsigned int degree, double* y) {
+	size_t i, j;
+	for (i = 0; i < n; i++) {
+		double v = 0;
+		for (j = 0; j < degree; j++) {
+			const double u = (x[i] - p[3*j+1])/p[3*j+2];
+			v += p[3*j]*exp(-u*u);
+		}
+		y[i] = v;
+	}
+}
+
+static void nsl_fit_gaussian_df(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda) {
+	size_t i, j;
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < degree; j++) {
+			const double a = p[3*j], c = p[3*j+2];
+			const double u = (x[i] - p[3*j+1])/c;
+			const double e = exp(-u*u);
+			J[i*tda+3*j] = e;
+			J[i*tda+3*j+1] = 2.*a*u*e/c;
+			J[i*tda+3*j+2] = 2.*a*u*u*e/c;
+		}
+	}
+}
+
+/* peak finding: the largest remaining maximum gives amplitude and position, the width follows from the drop to a/e.
+ * The peak is subtracted before the next one is searched. */
+static int nsl_fit_gaussian_guess(const double* x, const double* y, size_t n, unsigned int degree, double* p) {
+	double* r = (double*)malloc(n*sizeof(double));
+	double min, max;
+	size_t i, j;
+
+	nsl_fit_range(x, n, &min, &max);
+	for (i = 0; i < n; i++)
+		r[i] = y[i];
+
+	for (j = 0; j < degree; j++) {
+		const size_t imax = nsl_fit_argmax(r, n);
+		const double a = r[imax], b = x[imax];
+		double c = nsl_fit_peak_halfwidth(x, r, n, imax, a/M_E);
+		if (c <= 0)
+			c = (max - min)/(4.*degree);
+		if (c <= 0)
+			c = 1.0;
+
+		p[3*j] = a;
+		p[3*j+1] = b;
+		p[3*j+2] = c;
+
+		for (i = 0; i < n; i++) {
+			const double u = (x[i] - b)/c;
+			r[i] -= a*exp(-u*u);
+		}
+	}
+
+	free(r);
+	return 0;
+}
+
+/* Lorentz (Cauchy): 1/pi*s/(s^2+(x-t)^2) */
+
+static size_t nsl_fit_lorentz_nparams(unsigned int degree) {
+	(void)degree;
+	return 2;
+}
+
+static void nsl_fit_lorentz_f(const double* x, size_t n, const double* p, unsigned int degree, double* y) {
+	size_t i;
+	const double s = p[0], t = p[1];
+	(void)degree;
+	for (i = 0; i < n; i++)
+		y[i] = s/(M_PI*(s*s + (x[i]-t)*(x[i]-t)));
+}
+
+static void nsl_fit_lorentz_df(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda) {
+	size_t i;
+	const double s = p[0], t = p[1];
+	(void)degree;
+	for (i = 0; i < n; i++) {
+		const double d = s*s + (x[i]-t)*(x[i]-t);
+		J[i*tda] = ((x[i]-t)*(x[i]-t) - s*s)/(M_PI*d*d);
+		J[i*tda+1] = 2.*s*(x[i]-t)/(M_PI*d*d);
+	}
+}
+
+/* position of the maximum, half width at half maximum (or the height 1/(pi*s) as fallback) */
+static int nsl_fit_lorentz_guess(const double* x, const double* y, size_t n, unsigned int degree, double* p) {
+	const size_t imax = nsl_fit_argmax(y, n);
+	double s = nsl_fit_peak_halfwidth(x, y, n, imax, y[imax]/2.);
+	(void)degree;
+
+	if (s <= 0 && y[imax] > 0)
+		s = 1./(M_PI*y[imax]);
+	if (s <= 0)
+		return 1;
+
+	p[0] = s;
+	p[1] = x[imax];
+	return 0;
+}
+
+/* Maxwell-Boltzmann: sqrt(2/pi)*x^2*exp(-x^2/(2*a^2))/a^3 */
+
+static size_t nsl_fit_maxwell_nparams(unsigned int degree) {
+	(void)degree;
+	return 1;
+}
+
+static void nsl_fit_maxwell_f(const double* x, size_t n, const double* p, unsigned int degree, double* y) {
+	size_t i;
+	const double a = p[0];
+	(void)degree;
+	for (i = 0; i < n; i++)
+		y[i] = sqrt(2./M_PI)*x[i]*x[i]*exp(-x[i]*x[i]/(2.*a*a))/(a*a*a);
+}
+
+static void nsl_fit_maxwell_df(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda) {
+	size_t i;
+	const double a = p[0];
+	(void)degree;
+	for (i = 0; i < n; i++)
+		J[i*tda] = sqrt(2./M_PI)*x[i]*x[i]*(x[i]*x[i] - 3.*a*a)*exp(-x[i]*x[i]/(2.*a*a))/pow(a, 6);
+}
+
+/* the maximum of the distribution is at x = sqrt(2)*a */
+static int nsl_fit_maxwell_guess(const double* x, const double* y, size_t n, unsigned int degree, double* p) {
+	const size_t imax = nsl_fit_argmax(y, n);
+	(void)degree;
+
+	if (x[imax] == 0)
+		return 1;
+	p[0] = fabs(x[imax])/M_SQRT2;
+	return 0;
+}
+
+/* Sigmoid: a/(1+exp(-b*(x-c))) */
+
+static size_t nsl_fit_sigmoid_nparams(unsigned int degree) {
+	(void)degree;
+	return 3;
+}
+
+static void nsl_fit_sigmoid_f(const double* x, size_t n, const double* p, unsigned int degree, double* y) {
+	size_t i;
+	(void)degree;
+	for (i = 0; i < n; i++)
+		y[i] = p[0]/(1.0 + exp(-p[1]*(x[i]-p[2])));
+}
+
+static void nsl_fit_sigmoid_df(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda) {
+	size_t i;
+	const double a = p[0], b = p[1], c = p[2];
+	(void)degree;
+	for (i = 0; i < n; i++) {
+		const double e = exp(-b*(x[i]-c));
+		const double d = 1.0 + e;
+		J[i*tda] = 1.0/d;
+		J[i*tda+1] = a*(x[i]-c)*e/(d*d);
+		J[i*tda+2] = -a*b*e/(d*d);
+	}
+}
+
+/* plateau from the extreme value, center from the point closest to half of it, steepness from the data range */
+static int nsl_fit_sigmoid_guess(const double* x, const double* y, size_t n, unsigned int degree, double* p) {
+	double min, max, ymin = y[0], ymax = y[0];
+	size_t i, ic = 0, ixmin = 0, ixmax = 0;
+	(void)degree;
+
+	nsl_fit_range(x, n, &min, &max);
+	if (max == min)
+		return 1;
+
+	for (i = 1; i < n; i++) {
+		if (y[i] < ymin)
+			ymin = y[i];
+		if (y[i] > ymax)
+			ymax = y[i];
+		if (x[i] < x[ixmin])
+			ixmin = i;
+		if (x[i] > x[ixmax])
+			ixmax = i;
+	}
+	p[0] = (fabs(ymax) >= fabs(ymin)) ? ymax : ymin;
+
+	for (i = 1; i < n; i++)
+		if (fabs(y[i] - p[0]/2.) < fabs(y[ic] - p[0]/2.))
+			ic = i;
+	p[2] = x[ic];
+
+	/* rising if the values approach the plateau with increasing x */
+	p[1] = 8./(max - min);
+	if ((y[ixmax] - y[ixmin])*p[0] < 0)
+		p[1] = -p[1];
+
+	return 0;
+}
+
+/* model table */
+
+static const nsl_fit_model nsl_fit_models[NSL_FIT_MODEL_TYPE_COUNT] = {
+	{"polynomial", nsl_fit_polynomial_nparams, nsl_fit_polynomial_f, nsl_fit_polynomial_df, nsl_fit_polynomial_guess},
+	{"power", nsl_fit_power_nparams, nsl_fit_power_f, nsl_fit_power_df, nsl_fit_power_guess},
+	{"exponential", nsl_fit_exponential_nparams, nsl_fit_exponential_f, nsl_fit_exponential_df, nsl_fit_exponential_guess},
+	{"inverse exponential", nsl_fit_inverse_exponential_nparams, nsl_fit_inverse_exponential_f, nsl_fit_inverse_exponential_df,
+		nsl_fit_inverse_exponential_guess},
+	{"fourier", nsl_fit_fourier_nparams, nsl_fit_fourier_f, nsl_fit_fourier_df, nsl_fit_fourier_guess},
+	{"gaussian", nsl_fit_gaussian_nparams, nsl_fit_gaussian_f, nsl_fit_gaussian_df, nsl_fit_gaussian_guess},
+	{"lorentz", nsl_fit_lorentz_nparams, nsl_fit_lorentz_f, nsl_fit_lorentz_df, nsl_fit_lorentz_guess},
+	{"maxwell", nsl_fit_maxwell_nparams, nsl_fit_maxwell_f, nsl_fit_maxwell_df, nsl_fit_maxwell_guess},
+	{"sigmoid", nsl_fit_sigmoid_nparams, nsl_fit_sigmoid_f, nsl_fit_sigmoid_df, nsl_fit_sigmoid_guess}
+};
+
+const nsl_fit_model* nsl_fit_model_get(nsl_fit_model_type type) {
+	if ((int)type < 0 || type >= NSL_FIT_MODEL_TYPE_COUNT)
+		return NULL;
+	return &nsl_fit_models[type];
+}
+
+/* parameter transformation: sin() for two limits, sqrt(x^2+1) for one limit (as in MINUIT) */
+
+double nsl_fit_map_bound(double x, double min, double max) {
+	if (min > -DBL_MAX && max < DBL_MAX)
+		return min + (max - min)/2.*(1. + sin(x));
+	if (min > -DBL_MAX)
+		return min - 1. + sqrt(x*x + 1.);
+	if (max < DBL_MAX)
+		return max + 1. - sqrt(x*x + 1.);
+
+	return x;
+}
+
+/* values on or beyond a limit are moved inside by this fraction of the range (of |limit|+1 for one limit):
+ * the derivative of the mapping vanishes at the limits, so the parameter could never leave them */
+#define NSL_FIT_LIMIT_OFFSET 1.e-3
+
+double nsl_fit_map_unbound(double x, double min, double max) {
+	if (min > -DBL_MAX && max < DBL_MAX) {
+		if (max <= min)
+			return 0;
+		const double offset = NSL_FIT_LIMIT_OFFSET*(max - min);
+		if (x < min + offset)
+			x = min + offset;
+		if (x > max - offset)
+			x = max - offset;
+		return asin(2.*(x - min)/(max - min) - 1.);
+	}
+	if (min > -DBL_MAX) {
+		const double offset = NSL_FIT_LIMIT_OFFSET*(fabs(min) + 1.);
+		if (x < min + offset)
+			x = min + offset;
+		return sqrt((x - min + 1.)*(x - min + 1.) - 1.);
+	}
+	if (max < DBL_MAX) {
+		const double offset = NSL_FIT_LIMIT_OFFSET*(fabs(max) + 1.);
+		if (x > max - offset)
+			x = max - offset;
+		return sqrt((max - x + 1.)*(max - x + 1.) - 1.);
+	}
+
+	return x;
+}
+
+double nsl_fit_map_bound_deriv(double x, double min, double max) {
+	if (min > -DBL_MAX && max < DBL_MAX)
+		return (max - min)/2.*cos(x);
+	if (min > -DBL_MAX)
+		return x/sqrt(x*x + 1.);
+	if (max < DBL_MAX)
+		return -x/sqrt(x*x + 1.);
+
+	return 1.;
+}
@@ -0,0 +1,70 @@
+/***************************************************************************
+    File                 : nsl_fit.h
+    Project              : LabPlot
+    Description          : NSL fit models
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef NSL_FIT_H
+#define NSL_FIT_H
+
+#include <stdlib.h>
+
+/* predefined fit models (same order as XYFitCurve::ModelType) */
+typedef enum {nsl_fit_model_polynomial, nsl_fit_model_power, nsl_fit_model_exponential, nsl_fit_model_inverse_exponential,
+	nsl_fit_model_fourier, nsl_fit_model_gaussian, nsl_fit_model_lorentz, nsl_fit_model_maxwell,
+	nsl_fit_model_sigmoid} nsl_fit_model_type;
+#define NSL_FIT_MODEL_TYPE_COUNT 9
+
+/* a fit model given by its value, Jacobian and initial guess kernels.
+ * The kernels work on whole arrays of data points:
+ *	f:	y[i] = f(x[i]; p) for i=0..n-1
+ *	df:	J[i*tda+j] = df(x[i]; p)/dp_j for i=0..n-1, j=0..nparams(degree)-1
+ *	guess:	estimate of the parameters p from the data (x[i], y[i]), returns 0 on success
+ */
+typedef struct {
+	const char* name;
+	size_t (*nparams)(unsigned int degree);
+	void (*f)(const double* x, size_t n, const double* p, unsigned int degree, double* y);
+	void (*df)(const double* x, size_t n, const double* p, unsigned int degree, double* J, size_t tda);
+	int (*guess)(const double* x, const double* y, size_t n, unsigned int degree, double* p);
+} nsl_fit_model;
+
+/* the fit model of type type */
+const nsl_fit_model* nsl_fit_model_get(nsl_fit_model_type type);
+
+/* least squares line y = a + b*x through the points with positive weight w (all points if w is NULL), returns 0 on success */
+int nsl_fit_linear(const double* x, const double* y, const double* w, size_t n, double* a, double* b);
+
+/* transformation of a parameter with the limits min and max (-DBL_MAX/DBL_MAX for no limit) to an unbounded parameter:
+ *	map_bound:	unbounded value x -> bounded value
+ *	map_unbound:	bounded value x -> unbounded value (x is moved strictly inside [min, max], since the derivative
+ *			of map_bound is zero at the limits and a parameter starting there would never move)
+ *	map_bound_deriv: derivative of map_bound at the unbounded value x
+ */
+double nsl_fit_map_bound(double x, double min, double max);
+double nsl_fit_map_unbound(double x, double min, double max);
+double nsl_fit_map_bound_deriv(double x, double min, double max);
+
+#endif /* NSL_FIT_H */
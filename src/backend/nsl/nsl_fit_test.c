@@ -0,0 +1,113 @@
+/***************************************************************************
+    File                 : nsl_fit_test.c
+    Project              : LabPlot
+    Description          : NSL fit model test
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+#include "nsl_fit.h"
+
+/* evaluate the model with parameters p, guess the parameters from the values and compare the Jacobian with finite differences */
+void test_model(nsl_fit_model_type type, unsigned int degree, const double* p, const double* x, size_t n) {
+	const nsl_fit_model* model = nsl_fit_model_get(type);
+	const size_t np = model->nparams(degree);
+	double y[100], yh[100], J[100*9], guess[9], ph[9];
+	double maxerr = 0;
+	size_t i, j;
+	int status;
+
+	model->f(x, n, p, degree, y);
+	model->df(x, n, p, degree, J, np);
+	for (j = 0; j < np; j++) {
+		const double h = 1.e-6*(fabs(p[j]) + 1.e-6);
+		for (i = 0; i < np; i++)
+			ph[i] = p[i];
+		ph[j] += h;
+		model->f(x, n, ph, degree, yh);
+		for (i = 0; i < n; i++) {
+			const double err = fabs((yh[i]-y[i])/h - J[i*np+j])/(fabs(J[i*np+j]) + 1.);
+			if (err > maxerr)
+				maxerr = err;
+		}
+	}
+
+	status = model->guess(x, y, n, degree, guess);
+	printf("%s (degree %u): Jacobian error %.2g, guess (status %d):", model->name, degree, maxerr, status);
+	for (j = 0; j < np; j++)
+		printf(" %g (%g)", guess[j], p[j]);
+	printf("\n");
+}
+
+int main() {
+	double x[100];
+	size_t i, n = 100;
+
+	for (i = 0; i < n; i++)
+		x[i] = 0.1*(i+1);
+
+	double ppoly[4] = {1, -2, 0.5, 0.1};
+	test_model(nsl_fit_model_polynomial, 3, ppoly, x, n);
+	double ppower1[2] = {2, 1.5};
+	test_model(nsl_fit_model_power, 1, ppower1, x, n);
+	double ppower2[3] = {1, 2, 0.5};
+	test_model(nsl_fit_model_power, 2, ppower2, x, n);
+	double pexp1[2] = {3, -0.4};
+	test_model(nsl_fit_model_exponential, 1, pexp1, x, n);
+	double pexp3[6] = {3, -0.4, 1, -0.1, 0.5, 0.2};
+	test_model(nsl_fit_model_exponential, 3, pexp3, x, n);
+	double pinvexp[3] = {2, -0.5, 1};
+	test_model(nsl_fit_model_inverse_exponential, 1, pinvexp, x, n);
+	double pfourier[6] = {0.8, 1, 2, 0.5, 0.3, -1};
+	test_model(nsl_fit_model_fourier, 2, pfourier, x, n);
+	double pgauss[6] = {3, 3, 0.8, 1, 7, 0.5};
+	test_model(nsl_fit_model_gaussian, 2, pgauss, x, n);
+	double plorentz[2] = {0.5, 4};
+	test_model(nsl_fit_model_lorentz, 1, plorentz, x, n);
+	double pmaxwell[1] = {2};
+	test_model(nsl_fit_model_maxwell, 1, pmaxwell, x, n);
+	double psigmoid[3] = {2, 1.5, 5};
+	test_model(nsl_fit_model_sigmoid, 1, psigmoid, x, n);
+
+	/* parameter transformation */
+	double limits[4][2] = {{-DBL_MAX, DBL_MAX}, {0, DBL_MAX}, {-DBL_MAX, 10}, {0, 10}};
+	/* 0 and 10 are on the limits, -1 is beyond them: they are moved inside, the derivative is not zero */
+	double values[6] = {0.5, 3, 9.9, 0, 10, -1};
+	for (i = 0; i < 4; i++) {
+		size_t j;
+		printf("limits [%g, %g]:", limits[i][0], limits[i][1]);
+		for (j = 0; j < 6; j++) {
+			const double u = nsl_fit_map_unbound(values[j], limits[i][0], limits[i][1]);
+			const double h = 1.e-6;
+			const double deriv = (nsl_fit_map_bound(u + h, limits[i][0], limits[i][1]) - nsl_fit_map_bound(u, limits[i][0], limits[i][1]))/h;
+			printf(" %g -> %g -> %g (derivative %g/%g)", values[j], u, nsl_fit_map_bound(u, limits[i][0], limits[i][1]),
+				nsl_fit_map_bound_deriv(u, limits[i][0], limits[i][1]), deriv);
+		}
+		printf("\n");
+	}
+
+	return 0;
+}
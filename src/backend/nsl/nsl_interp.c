@@ -0,0 +1,231 @@
+/***************************************************************************
+    File                 : nsl_interp.c
+    Project              : LabPlot
+    Description          : NSL interpolation functions
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "nsl_interp.h"
+#include <math.h>
+#include <float.h>
+#include <gsl/gsl_errno.h>
+
+size_t nsl_interp_find(const double* x, size_t n, double xi, size_t guess) {
+	size_t a = 0, b = n-1, j;
+
+	if (guess < n-1 && x[guess] <= xi) {
+		/* the points are usually evaluated in increasing order: try the next intervals first */
+		a = guess;
+		for (j = 0; j < 4 && a < n-2 && x[a+1] <= xi; j++)
+			a++;
+		if (a == n-2 || x[a+1] > xi)
+			return a;
+	}
+
+	while (b-a > 1) {	/* bisection */
+		j = (a+b)/2;
+		if (x[j] > xi)
+			b = j;
+		else
+			a = j;
+	}
+
+	return a;
+}
+
+void nsl_interp_cosine(const double* x, const double* y, size_t n, double xmin, double xmax, size_t m,
+		double* yi, size_t from, size_t to) {
+	size_t i, k, a = n;
+	double xa = 0, dx = 1, ya = 0, dy = 0;
+
+	for (i = from; i < to; i++) {
+		const double xv = xmin + i*(xmax-xmin)/(m-1);
+		double t;
+		k = nsl_interp_find(x, n, xv, a < n ? a : 0);
+		if (k != a) {
+			a = k;
+			xa = x[a];
+			dx = x[a+1] - x[a];
+			ya = y[a];
+			dy = y[a+1] - y[a];
+		}
+
+		t = (xv - xa)/dx;
+		t = (1. - cos(M_PI*t))/2.;
+		yi[i] = ya + t*dy;
+	}
+}
+
+void nsl_interp_exponential(const double* x, const double* y, size_t n, double xmin, double xmax, size_t m,
+		double* yi, size_t from, size_t to) {
+	size_t i, k, a = n;
+	double xa = 0, dx = 1, ya = 0, r = 1;
+
+	for (i = from; i < to; i++) {
+		const double xv = xmin + i*(xmax-xmin)/(m-1);
+		k = nsl_interp_find(x, n, xv, a < n ? a : 0);
+		if (k != a) {
+			a = k;
+			xa = x[a];
+			dx = x[a+1] - x[a];
+			ya = y[a];
+			r = y[a+1]/y[a];
+		}
+
+		yi[i] = ya*pow(r, (xv - xa)/dx);
+	}
+}
+
+/* slopes m1, m2 at the borders of the interval [x[a], x[a+1]] */
+static void nsl_interp_pch_slopes(const double* x, const double* y, size_t n, size_t a, nsl_interp_pch_variant variant,
+		double tension, double continuity, double bias, double* m1, double* m2) {
+	const size_t b = a+1;
+	const double s = (y[b]-y[a])/(x[b]-x[a]);
+
+	switch (variant) {
+	case nsl_interp_pch_variant_finite_difference:
+		if (a == 0)
+			*m1 = s;
+		else
+			*m1 = (s + (y[a]-y[a-1])/(x[a]-x[a-1]))/2.;
+		if (b == n-1)
+			*m2 = s;
+		else
+			*m2 = ((y[b+1]-y[b])/(x[b+1]-x[b]) + s)/2.;
+		break;
+	case nsl_interp_pch_variant_catmull_rom:
+	case nsl_interp_pch_variant_cardinal:
+		if (a == 0)
+			*m1 = s;
+		else
+			*m1 = (y[b]-y[a-1])/(x[b]-x[a-1]);
+		if (b == n-1)
+			*m2 = s;
+		else
+			*m2 = (y[b+1]-y[a])/(x[b+1]-x[a]);
+		if (variant == nsl_interp_pch_variant_cardinal) {
+			*m1 *= (1.-tension);
+			*m2 *= (1.-tension);
+		}
+		break;
+	case nsl_interp_pch_variant_kochanek_bartels:
+		if (a == 0)
+			*m1 = (1.+continuity)*(1.-bias)*s;
+		else
+			*m1 = ((1.-continuity)*(1.+bias)*(y[a]-y[a-1])/(x[a]-x[a-1]) + (1.+continuity)*(1.-bias)*s)/2.;
+		*m1 *= (1.-tension);
+		if (b == n-1)
+			*m2 = (1.+continuity)*(1.+bias)*s;
+		else
+			*m2 = ((1.+continuity)*(1.+bias)*s + (1.-continuity)*(1.-bias)*(y[b+1]-y[b])/(x[b+1]-x[b]))/2.;
+		*m2 *= (1.-tension);
+		break;
+	default:
+		*m1 = *m2 = 0;
+	}
+}
+
+void nsl_interp_pch(const double* x, const double* y, size_t n, nsl_interp_pch_variant variant,
+		double tension, double continuity, double bias, double xmin, double xmax, size_t m,
+		double* yi, size_t from, size_t to) {
+	size_t i, k, a = n;
+	double xa = 0, dx = 1, c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+
+	for (i = from; i < to; i++) {
+		const double xv = xmin + i*(xmax-xmin)/(m-1);
+		double t;
+		k = nsl_interp_find(x, n, xv, a < n ? a : 0);
+		if (k != a) {
+			double m1, m2;
+			a = k;
+			nsl_interp_pch_slopes(x, y, n, a, variant, tension, continuity, bias, &m1, &m2);
+			xa = x[a];
+			dx = x[a+1] - x[a];
+			/* Hermite polynomial y[a]*h00 + y[a+1]*h01 + dx*(m1*h10 + m2*h11) in powers of t */
+			m1 *= dx;
+			m2 *= dx;
+			c0 = y[a];
+			c1 = m1;
+			c2 = -3.*y[a] + 3.*y[a+1] - 2.*m1 - m2;
+			c3 = 2.*y[a] - 2.*y[a+1] + m1 + m2;
+		}
+
+		t = (xv - xa)/dx;
+		yi[i] = c0 + t*(c1 + t*(c2 + t*c3));
+	}
+}
+
+int nsl_interp_rational(const double* x, const double* y, size_t n, double xmin, double xmax, size_t m,
+		double* yi, size_t from, size_t to) {
+	size_t i;
+	double v, dv;
+	double* work = (double*)malloc(2*n*sizeof(double));
+	if (work == NULL)
+		return GSL_ENOMEM;
+
+	for (i = from; i < to; i++) {
+		nsl_interp_ratint(x, y, n, xmin + i*(xmax-xmin)/(m-1), &v, &dv, work);
+		yi[i] = v;
+	}
+
+	free(work);
+	return GSL_SUCCESS;
+}
+
+void nsl_interp_ratint(const double* x, const double* y, size_t n, double xn, double* v, double* dv, double* work) {
+	double* c = work;
+	double* d = work + n;
+	double t, dd;
+	const size_t a = nsl_interp_find(x, n, xn, 0);
+	int i, j, ns = (int)a;	/* nearest index */
+
+	if (fabs(xn-x[a]) > fabs(xn-x[a+1]))
+		ns = (int)a+1;
+
+	if (xn == x[ns]) {	/* exact point */
+		*v = y[ns];
+		*dv = 0;
+		return;
+	}
+
+	for (i = 0; i < (int)n; i++)
+		c[i] = d[i] = y[i];
+
+	*v = y[ns--];
+
+	for (j = 1; j < (int)n; j++) {
+		for (i = 0; i < (int)n-j; i++) {
+			t = (x[i]-xn)*d[i]/(x[i+j]-xn);
+			dd = t-c[i+1];
+			if (dd == 0.0)	/* pole */
+				dd += DBL_MIN;
+			dd = (c[i+1]-d[i])/dd;
+			d[i] = c[i+1]*dd;
+			c[i] = t*dd;
+		}
+
+		*dv = (2*(ns+1) < (int)n-j ? c[ns+1] : d[ns--]);
+		*v += *dv;
+	}
+}
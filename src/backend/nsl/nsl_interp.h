@@ -0,0 +1,68 @@
+/***************************************************************************
+    File                 : nsl_interp.h
+    Project              : LabPlot
+    Description          : NSL interpolation functions
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef NSL_INTERP_H
+#define NSL_INTERP_H
+
+#include <stdlib.h>
+
+/* variants of the piecewise cubic Hermite interpolation (same order as XYInterpolationCurve::CubicHermiteVariant) */
+typedef enum {nsl_interp_pch_variant_finite_difference, nsl_interp_pch_variant_catmull_rom,
+	nsl_interp_pch_variant_cardinal, nsl_interp_pch_variant_kochanek_bartels} nsl_interp_pch_variant;
+
+/* All evaluators interpolate the n >= 2 points (x, y) with increasing x at the points
+ * xi = xmin + i*(xmax-xmin)/(m-1) for i = from..to-1 and write the values to yi[i].
+ * The interval is found by walking forward from the previous one and the interval coefficients
+ * are only calculated when the interval changes, so that a range costs O(n + to - from).
+ * Different ranges can be evaluated independently, e.g. in parallel.
+ */
+
+/* index a of the interval [x[a], x[a+1]] containing xi (0 <= a <= n-2, the outer intervals are extrapolated).
+ * The search starts at guess and falls back to bisection. */
+size_t nsl_interp_find(const double* x, size_t n, double xi, size_t guess);
+
+/* cosine interpolation */
+void nsl_interp_cosine(const double* x, const double* y, size_t n, double xmin, double xmax, size_t m,
+	double* yi, size_t from, size_t to);
+/* exponential interpolation y[a]*(y[a+1]/y[a])^t */
+void nsl_interp_exponential(const double* x, const double* y, size_t n, double xmin, double xmax, size_t m,
+	double* yi, size_t from, size_t to);
+/* piecewise cubic Hermite interpolation (tension is used by cardinal and Kochanek-Bartels,
+ * continuity and bias only by Kochanek-Bartels) */
+void nsl_interp_pch(const double* x, const double* y, size_t n, nsl_interp_pch_variant variant,
+	double tension, double continuity, double bias, double xmin, double xmax, size_t m,
+	double* yi, size_t from, size_t to);
+/* rational interpolation through all points (Bulirsch-Stoer), O(n^2) per point */
+int nsl_interp_rational(const double* x, const double* y, size_t n, double xmin, double xmax, size_t m,
+	double* yi, size_t from, size_t to);
+
+/* rational interpolation of the n points at xn using the Bulirsch-Stoer method with the work array
+ * work of 2*n values. result in v (error estimate dv) */
+void nsl_interp_ratint(const double* x, const double* y, size_t n, double xn, double* v, double* dv, double* work);
+
+#endif /* NSL_INTERP_H */
@@ -0,0 +1,64 @@
+/***************************************************************************
+    File                 : nsl_interp_pch_test.c
+    Project              : LabPlot
+    Description          : NSL PCH interpolation test
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "nsl_interp.h"
+
+int main() {
+	double x[] = {0, 1, 2, 3, 4};
+	double y[] = {0, 1, 0, 1, 0};
+	const size_t n = 5, m = 9;
+	double yi[9];
+	size_t i;
+	int v;
+
+	/* all variants pass through the data points at 0, 1, .., 4:
+	   0 0.625 1 0.5 0 0.5 1 0.625 0 (finite difference)
+	   0 0.625 1 0.5 0 0.5 1 0.625 0 (Catmull-Rom)
+	   0 0.5625 1 0.5 0 0.5 1 0.5625 0 (cardinal, tension 0.5)
+	   0 0.5488 1 0.5125 0 0.4875 1 0.5763 0 (Kochanek-Bartels) */
+	for (v = nsl_interp_pch_variant_finite_difference; v <= nsl_interp_pch_variant_kochanek_bartels; v++) {
+		nsl_interp_pch(x, y, n, v, 0.5, 0.2, 0.1, 0, 4, m, yi, 0, m);
+		for (i = 0; i < m; i++)
+			printf(" %.4g", fabs(yi[i]) < 1.e-12 ? 0 : yi[i]);
+		printf("\n");
+	}
+
+	/* a straight line is reproduced by the finite difference and Catmull-Rom variants: 0 0.5 1 .. 4 */
+	for (i = 0; i < n; i++)
+		y[i] = x[i];
+	for (v = nsl_interp_pch_variant_finite_difference; v <= nsl_interp_pch_variant_catmull_rom; v++) {
+		nsl_interp_pch(x, y, n, v, 0, 0, 0, 0, 4, m, yi, 0, m);
+		for (i = 0; i < m; i++)
+			printf(" %.4g", yi[i]);
+		printf("\n");
+	}
+
+	return 0;
+}
@@ -0,0 +1,74 @@
+/***************************************************************************
+    File                 : nsl_interp_test.c
+    Project              : LabPlot
+    Description          : NSL interpolation test
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "nsl_interp.h"
+
+int main() {
+	double x[] = {0, 1, 2, 4, 5};
+	double y[] = {1, 2, 4, 16, 32};
+	const size_t n = 5, m = 11;
+	double yi[11];
+	size_t i;
+
+	/* interval search: 0 0 1 2 2 3 3 */
+	double xs[] = {-1, 0.5, 1, 2, 3.9, 4, 6};
+	for (i = 0; i < 7; i++)
+		printf(" %zu", nsl_interp_find(x, n, xs[i], 0));
+	printf("\n");
+
+	/* cosine at 0, 0.5, .., 5: 1 1.5 2 3 4 5.757 10 14.24 16 24 32 */
+	nsl_interp_cosine(x, y, n, 0, 5, m, yi, 0, m);
+	for (i = 0; i < m; i++)
+		printf(" %.4g", yi[i]);
+	printf("\n");
+
+	/* exponential reproduces y = 2^x exactly: 1 1.414 2 2.828 .. 32 */
+	nsl_interp_exponential(x, y, n, 0, 5, m, yi, 0, m);
+	for (i = 0; i < m; i++)
+		printf(" %.4g", yi[i]);
+	printf("\n");
+
+	/* rational interpolation of 1/(1+x^2) is exact: 1 0.8 0.5 0.3077 0.2 0.1379 0.1 0.07547 0.05882 0.04706 0.03846 */
+	for (i = 0; i < n; i++)
+		y[i] = 1./(1.+x[i]*x[i]);
+	nsl_interp_rational(x, y, n, 0, 5, m, yi, 0, m);
+	for (i = 0; i < m; i++)
+		printf(" %.4g", yi[i]);
+	printf("\n");
+
+	/* ranges evaluated independently give the same result */
+	nsl_interp_rational(x, y, n, 0, 5, m, yi, 0, 4);
+	nsl_interp_rational(x, y, n, 0, 5, m, yi, 4, m);
+	for (i = 0; i < m; i++)
+		printf(" %.4g", yi[i]);
+	printf("\n");
+
+	return 0;
+}
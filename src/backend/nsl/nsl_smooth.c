@@ -31,329 +31,582 @@
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_sf_gamma.h>   /* gsl_sf_choose */
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
 #include "nsl_smooth.h"
 #include "nsl_sf_kernel.h"
-#include "nsl_stats.h"
 
 double nsl_smooth_pad_constant_lvalue = 0.0, nsl_smooth_pad_constant_rvalue = 0.0;
 
-int nsl_smooth_moving_average(double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode) {
-	unsigned int i,j;
-	double *result = (double *)malloc(n*sizeof(double));
-	for (i=0; i<n; i++)
-		result[i]=0;
-
-	for(i=0;i<n;i++) {
-		unsigned int np=points;
-		unsigned int half=(points-1)/2;
-		if(mode == nsl_smooth_pad_none) { /* reduce points */
-			half = GSL_MIN(GSL_MIN((points-1)/2,i),n-i-1);
-			np = 2*half+1;
+/* the running sums of the uniform moving average are recalculated from scratch at every NSL_SMOOTH_SUM_RESTART-th point.
+ * This bounds the accumulation of rounding errors and makes the result independent of the part of the signal being processed. */
+#define NSL_SMOOTH_SUM_RESTART 4096
+/* windows with at least this number of points are convolved via FFT */
+#define NSL_SMOOTH_FFT_POINTS 64
+/* number of cached Savitzky-Golay coefficient sets */
+#define NSL_SMOOTH_SAVGOL_CACHE_SIZE 8
+
+/* value of data at index, extended beyond the signal according to mode */
+static double nsl_smooth_pad_value(const double *data, unsigned int n, int index, nsl_smooth_pad_mode mode) {
+	if (index >= 0 && index < (int)n)
+		return data[index];
+
+	switch(mode) {
+	case nsl_smooth_pad_mirror:
+		if (n == 1)
+			return data[0];
+		/* reflect at both ends until the index is inside the signal */
+		while (index < 0 || index > (int)n-1) {
+			index = abs(index);
+			index = GSL_MIN(index, 2*((int)n-1)-index);
 		}
+		return data[index];
+	case nsl_smooth_pad_nearest:
+		return (index < 0) ? data[0] : data[n-1];
+	case nsl_smooth_pad_constant:
+		return (index < 0) ? nsl_smooth_pad_constant_lvalue : nsl_smooth_pad_constant_rvalue;
+	case nsl_smooth_pad_periodic:
+		index %= (int)n;
+		if (index < 0)
+			index += n;
+		return data[index];
+	case nsl_smooth_pad_none:
+	case nsl_smooth_pad_interp:
+		break;
+	}
 
-		/* weight */
-		double sum=0.0, *w = (double *)malloc(np*sizeof(double));
-		switch(weight) {
-		case nsl_smooth_weight_uniform:
-			for(j=0;j<np;j++)
-				w[j]=1./np;
-			break;
-		case nsl_smooth_weight_triangular:
-			sum = gsl_pow_2((np+1)/2);
-			for(j=0;j<np;j++)
-				w[j]=GSL_MIN(j+1,np-j)/sum;
-			break;
-		case nsl_smooth_weight_binomial:
-			sum = (np-1)/2.;
+	return 0;
+}
+
+/* weights of the moving average over np points */
+static void nsl_smooth_weights(double *w, unsigned int np, nsl_smooth_weight_type weight) {
+	unsigned int j;
+	double sum=0.0;
+
+	switch(weight) {
+	case nsl_smooth_weight_uniform:
+		for(j=0;j<np;j++)
+			w[j]=1./np;
+		break;
+	case nsl_smooth_weight_triangular:
+		sum = gsl_pow_2((np+1)/2);
+		for(j=0;j<np;j++)
+			w[j]=GSL_MIN(j+1,np-j)/sum;
+		break;
+	case nsl_smooth_weight_binomial:
+		sum = (np-1)/2.;
+		if (sum <= 500) {
 			for(j=0;j<np;j++)
 				w[j]=gsl_sf_choose(2*sum,sum+fabs(j-sum))/pow(4.,sum);
-			break;
-		case nsl_smooth_weight_parabolic:
-			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_parabolic(2.*(j-(np-1)/2.)/(np+1));
-				sum += w[j];
-			}
-			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_quartic:
-			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_quartic(2.*(j-(np-1)/2.)/(np+1));
-				sum += w[j];
-			}
+		} else {	/* avoid overflow of the binomial coefficients */
 			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_triweight:
-			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_triweight(2.*(j-(np-1)/2.)/(np+1));
-				sum += w[j];
-			}
-			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_tricube:
+				w[j]=exp(gsl_sf_lnchoose(2*sum,sum+fabs(j-sum))-sum*log(4.));
+		}
+		break;
+	case nsl_smooth_weight_parabolic:
+		for(j=0;j<np;j++) {
+			w[j]=nsl_sf_kernel_parabolic(2.*(j-(np-1)/2.)/(np+1));
+			sum += w[j];
+		}
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_quartic:
+		for(j=0;j<np;j++) {
+			w[j]=nsl_sf_kernel_quartic(2.*(j-(np-1)/2.)/(np+1));
+			sum += w[j];
+		}
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_triweight:
+		for(j=0;j<np;j++) {
+			w[j]=nsl_sf_kernel_triweight(2.*(j-(np-1)/2.)/(np+1));
+			sum += w[j];
+		}
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_tricube:
+		for(j=0;j<np;j++) {
+			w[j]=nsl_sf_kernel_tricube(2.*(j-(np-1)/2.)/(np+1));
+			sum += w[j];
+		}
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_cosine:
+		for(j=0;j<np;j++) {
+			w[j]=nsl_sf_kernel_cosine((j-(np-1)/2.)/((np+1)/2.));
+			sum += w[j];
+		}
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
+	}
+}
+
+/* weights of the lagged moving average over np points */
+static void nsl_smooth_weights_lagged(double *w, unsigned int np, nsl_smooth_weight_type weight) {
+	unsigned int j;
+	double sum=0.0;
+
+	switch(weight) {
+	case nsl_smooth_weight_uniform:
+		for(j=0;j<np;j++)
+			w[j]=1./np;
+		break;
+	case nsl_smooth_weight_triangular:
+		sum = np*(np+1)/2;
+		for(j=0;j<np;j++)
+			w[j]=(j+1)/sum;
+		break;
+	case nsl_smooth_weight_binomial:
+		if (np <= 500) {
 			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_tricube(2.*(j-(np-1)/2.)/(np+1));
+				w[j]=gsl_sf_choose(2*(np-1),j);
 				sum += w[j];
 			}
-			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_cosine:
+		} else {	/* avoid overflow of the binomial coefficients, scale by the largest one */
 			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_cosine((j-(np-1)/2.)/((np+1)/2.));
+				w[j]=exp(gsl_sf_lnchoose(2*(np-1),j)-gsl_sf_lnchoose(2*(np-1),np-1));
 				sum += w[j];
 			}
-			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
 		}
-
-		/*printf("(%d) w:",i);
 		for(j=0;j<np;j++)
-			printf(" %g",w[j]);
-		printf(" (half=%d) index = ",half);*/
-
-		/* calculate weighted average */
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_parabolic:
 		for(j=0;j<np;j++) {
-			int index=i-half+j;
-			switch(mode) {
-			case nsl_smooth_pad_none:
-				result[i] += w[j]*data[index];
-				break;
-			case nsl_smooth_pad_interp:
-				printf("not implemented yet\n");
-				break;
-			case nsl_smooth_pad_mirror:
-				index=abs(i-half+j);
-				/*printf(" %d",GSL_MIN(index,2*(n-1)-index));*/
-				result[i] += w[j]*data[GSL_MIN(index,2*(n-1)-index)];
-				break;
-			case nsl_smooth_pad_nearest:
-				/*printf(" %d",GSL_MIN(n-1,GSL_MAX(0,index)));*/
-				result[i] += w[j]*data[GSL_MIN(n-1,GSL_MAX(0,index))];
-				break;
-			case nsl_smooth_pad_constant:
-				if(index<0)
-					result[i] += w[j]*nsl_smooth_pad_constant_lvalue;
-				else if(index>(int)n-1)
-					result[i] += w[j]*nsl_smooth_pad_constant_rvalue;
-				else
-					result[i] += w[j]*data[index];
-				break;
-			case nsl_smooth_pad_periodic:
-				if(index<0)
-					index = n+index;
-				else if(index>(int)n-1)
-					index = index-n;
-				result[i] += w[j]*data[index];
-				break;
-			}
+			w[j]=nsl_sf_kernel_parabolic(1.-(1+j)/(double)np);
+			sum += w[j];
+		}
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_quartic:
+		for(j=0;j<np;j++) {
+			w[j]=nsl_sf_kernel_quartic(1.-(1+j)/(double)np);
+			sum += w[j];
+		}
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_triweight:
+		for(j=0;j<np;j++) {
+			w[j]=nsl_sf_kernel_triweight(1.-(1+j)/(double)np);
+			sum += w[j];
 		}
-		/*puts("");*/
-		free(w);
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_tricube:
+		for(j=0;j<np;j++) {
+			w[j]=nsl_sf_kernel_tricube(1.-(1+j)/(double)np);
+			sum += w[j];
+		}
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
+	case nsl_smooth_weight_cosine:
+		for(j=0;j<np;j++) {
+			w[j]=nsl_sf_kernel_cosine((np-1-j)/(double)np);
+			sum += w[j];
+		}
+		for(j=0;j<np;j++)
+			w[j] /= sum;
+		break;
 	}
-	
-	for (i=0; i<n; i++)
-		data[i]=result[i];
-	free(result);
+}
 
-	return 0;
+/* mean of data[i-offset], ..., data[i-offset+points-1] for i=from..to-1 using running sums */
+static void nsl_smooth_running_mean(const double *data, unsigned int points, unsigned int offset, double *result, unsigned int from, unsigned int to) {
+	unsigned int i,j;
+	double sum=0.0;
+
+	/* start at the last restart of the sum before from */
+	for(i=offset+(from-offset)/NSL_SMOOTH_SUM_RESTART*NSL_SMOOTH_SUM_RESTART;i<to;i++) {
+		const double *window = data+i-offset;
+		if((i-offset)%NSL_SMOOTH_SUM_RESTART == 0) {
+			sum=0.0;
+			for(j=0;j<points;j++)
+				sum += window[j];
+		} else
+			sum += window[points-1]-window[-1];
+
+		if(i>=from)
+			result[i]=sum/points;
+	}
 }
 
-int nsl_smooth_moving_average_lagged(double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode) {
+/* multiply the halfcomplex arrays a and b of length L (result in a) */
+static void nsl_smooth_halfcomplex_mult(double *a, const double *b, size_t L) {
+	size_t k;
+	a[0] *= b[0];
+	a[L/2] *= b[L/2];
+	for(k=1;k<L/2;k++) {
+		const double re = a[k]*b[k]-a[L-k]*b[L-k];
+		const double im = a[k]*b[L-k]+a[L-k]*b[k];
+		a[k] = re;
+		a[L-k] = im;
+	}
+}
+
+/* weighted sum result[i] = w[0]*data[i-offset] + ... + w[points-1]*data[i-offset+points-1] for i=from..to-1.
+ * All used values have to be inside the signal of length n.
+ * Large windows are convolved via FFT (overlap-save) with segments at fixed positions, so the result
+ * does not depend on the part of the signal being processed. */
+static void nsl_smooth_convolve(const double *data, unsigned int n, const double *w, unsigned int points, unsigned int offset,
+		double *result, unsigned int from, unsigned int to) {
 	unsigned int i,j;
+
+	if(points < NSL_SMOOTH_FFT_POINTS) {
+		for(i=from;i<to;i++) {
+			const double *window = data+i-offset;
+			double sum=0.0;
+			for(j=0;j<points;j++)
+				sum += w[j]*window[j];
+			result[i]=sum;
+		}
+		return;
+	}
+
+	size_t L=1, m, s;
+	while(L < 4*(size_t)points)
+		L *= 2;
+	const size_t M = L-points+1;	/* number of results per segment */
+
+	/* transform of the reversed weights */
+	double *h = (double *)calloc(L, sizeof(double));
+	double *u = (double *)malloc(L*sizeof(double));
+	for(j=0;j<points;j++)
+		h[j] = w[points-1-j];
+	gsl_fft_real_radix2_transform(h, 1, L);
+
+	for(s=offset+(from-offset)/M*M;s<to;s+=M) {
+		for(m=0;m<L;m++)
+			u[m] = (s-offset+m < n) ? data[s-offset+m] : 0.0;
+		gsl_fft_real_radix2_transform(u, 1, L);
+		nsl_smooth_halfcomplex_mult(u, h, L);
+		gsl_fft_halfcomplex_radix2_inverse(u, 1, L);
+
+		for(m=0;m<M;m++)
+			if(s+m >= from && s+m < to)
+				result[s+m] = u[points-1+m];
+	}
+
+	free(h);
+	free(u);
+}
+
+int nsl_smooth_moving_average(double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode) {
+	unsigned int i;
 	double *result = (double *)malloc(n*sizeof(double));
-	for (i=0; i<n; i++)
-		result[i]=0;
+	int status = nsl_smooth_moving_average_range(data, n, points, weight, mode, result, 0, n);
 
-	for(i=0;i<n;i++) {
-		unsigned int np=points;
-		unsigned int half=(points-1)/2;
-		if(mode == nsl_smooth_pad_none) { /* reduce points */
-			np = GSL_MIN(points,i+1);
-			half = np-1;
+	if (status == 0)
+		for (i=0; i<n; i++)
+			data[i]=result[i];
+	free(result);
+
+	return status;
+}
+
+int nsl_smooth_moving_average_range(const double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode,
+		double *result, unsigned int from, unsigned int to) {
+	unsigned int i,j;
+	if(points < 1)
+		return -1;
+	if(mode == nsl_smooth_pad_interp) {
+		printf("not implemented yet\n");
+		return -1;
+	}
+	if(from >= to)
+		return 0;
+
+	const unsigned int half=(points-1)/2;
+	/* without padding an even window is reduced to 2*half+1 points as at the edges */
+	if(mode == nsl_smooth_pad_none)
+		points = 2*half+1;
+	/* central part with the whole window data[i-half], ..., data[i-half+points-1] inside the signal */
+	const unsigned int right = points-1-half;
+	const unsigned int cfrom = GSL_MAX(from, half), cto = (n > right) ? GSL_MIN(to, n-right) : 0;
+	double *w = (double *)malloc(points*sizeof(double));
+	nsl_smooth_weights(w, points, weight);
+
+	/* edges */
+	for(i=from;i<to;i++) {
+		if(i == cfrom && cfrom < cto) {	/* skip the central part */
+			i = cto-1;
+			continue;
 		}
 
-		/* weight */
-		double sum=0.0, *w = (double *)malloc(np*sizeof(double));
-		switch(weight) {
-		case nsl_smooth_weight_uniform:
-			for(j=0;j<np;j++)
-				w[j]=1./np;
-			break;
-		case nsl_smooth_weight_triangular:
-			sum = np*(np+1)/2;
-			for(j=0;j<np;j++)
-				w[j]=(j+1)/sum;
-			break;
-		case nsl_smooth_weight_binomial:
-			for(j=0;j<np;j++) {
-				w[j]=gsl_sf_choose(2*(np-1),j);
-				sum += w[j];
-			}
-			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_parabolic:
-			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_parabolic(1.-(1+j)/(double)np);
-				sum += w[j];
-			}
-			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_quartic:
-			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_quartic(1.-(1+j)/(double)np);
-				sum += w[j];
-			}
-			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_triweight:
-			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_triweight(1.-(1+j)/(double)np);
-				sum += w[j];
-			}
-			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_tricube:
-			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_tricube(1.-(1+j)/(double)np);
-				sum += w[j];
-			}
-			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
-		case nsl_smooth_weight_cosine:
-			for(j=0;j<np;j++) {
-				w[j]=nsl_sf_kernel_cosine((np-1-j)/(double)np);
-				sum += w[j];
-			}
+		if(mode == nsl_smooth_pad_none) { /* reduce points */
+			const unsigned int rhalf = GSL_MIN(GSL_MIN(half,i),n-i-1);
+			const unsigned int np = 2*rhalf+1;
+			double *rw = (double *)malloc(np*sizeof(double));
+			nsl_smooth_weights(rw, np, weight);
+			result[i]=0;
 			for(j=0;j<np;j++)
-				w[j] /= sum;
-			break;
+				result[i] += rw[j]*data[i-rhalf+j];
+			free(rw);
+		} else {
+			result[i]=0;
+			for(j=0;j<points;j++)
+				result[i] += w[j]*nsl_smooth_pad_value(data, n, (int)(i+j)-(int)half, mode);
 		}
+	}
 
-		/*printf("(%d) w:",i);
-		for(j=0;j<np;j++)
-			printf(" %g",w[j]);
-		printf(" (half=%d) index = ",half);*/
-
-		/* calculate weighted average */
-		for(j=0;j<np;j++) {
-			int index=i-np+1+j;
-			switch(mode) {
-			case nsl_smooth_pad_none:
-				result[i] += w[j]*data[i-half+j];
-				/*printf(" %d",index);*/
-				break;
-			case nsl_smooth_pad_interp:
-				printf("not implemented yet\n");
-				break;
-			case nsl_smooth_pad_mirror:
-				index=abs(index);
-				/*printf(" %d",index);*/
-				result[i] += w[j]*data[index];
-				break;
-			case nsl_smooth_pad_nearest:
-				/*printf(" %d",GSL_MAX(0,index));*/
-				result[i] += w[j]*data[index];
-				break;
-			case nsl_smooth_pad_constant:
-				if(index < 0)
-					result[i] += w[j]*nsl_smooth_pad_constant_lvalue;
-				else
-					result[i] += w[j]*data[index];
-
-				break;
-			case nsl_smooth_pad_periodic:
-				if(index < 0)
-					index += n;
-				/*printf(" %d",index);*/
-				result[i] += w[j]*data[index];
-				break;
-			}
-		}
-		/*puts("");*/
-		free(w);
+	if(cfrom < cto) {
+		if(weight == nsl_smooth_weight_uniform)
+			nsl_smooth_running_mean(data, points, half, result, cfrom, cto);
+		else
+			nsl_smooth_convolve(data, n, w, points, half, result, cfrom, cto);
 	}
 
-	for (i=0; i<n; i++)
-		data[i]=result[i];
-	free(result);
+	free(w);
 
 	return 0;
 }
 
-int nsl_smooth_percentile(double *data, unsigned int n, unsigned int points, double percentile, nsl_smooth_pad_mode mode) {
-	unsigned int i,j;
+int nsl_smooth_moving_average_lagged(double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode) {
+	unsigned int i;
 	double *result = (double *)malloc(n*sizeof(double));
+	int status = nsl_smooth_moving_average_lagged_range(data, n, points, weight, mode, result, 0, n);
+
+	if (status == 0)
+		for (i=0; i<n; i++)
+			data[i]=result[i];
+	free(result);
+
+	return status;
+}
+
+int nsl_smooth_moving_average_lagged_range(const double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode,
+		double *result, unsigned int from, unsigned int to) {
+	unsigned int i,j;
+	if(points < 1)
+		return -1;
+	if(mode == nsl_smooth_pad_interp) {
+		printf("not implemented yet\n");
+		return -1;
+	}
+	if(from >= to)
+		return 0;
+
+	double *w = (double *)malloc(points*sizeof(double));
+	nsl_smooth_weights_lagged(w, points, weight);
 
-	for(i=0;i<n;i++) {
-		unsigned int np=points;
-		unsigned int half=(points-1)/2;
+	/* left edge */
+	for(i=from;i<GSL_MIN(points-1,to);i++) {
 		if(mode == nsl_smooth_pad_none) { /* reduce points */
-			half = GSL_MIN(GSL_MIN((points-1)/2,i),n-i-1);
-			np = 2*half+1;
+			const unsigned int np = i+1;
+			double *rw = (double *)malloc(np*sizeof(double));
+			nsl_smooth_weights_lagged(rw, np, weight);
+			result[i]=0;
+			for(j=0;j<np;j++)
+				result[i] += rw[j]*data[j];
+			free(rw);
+		} else {
+			result[i]=0;
+			for(j=0;j<points;j++)
+				result[i] += w[j]*nsl_smooth_pad_value(data, n, (int)(i+j)-(int)(points-1), mode);
 		}
+	}
 
-		double *values = (double *)malloc(np*sizeof(double));
-		for(j=0;j<np;j++) {
-			int index = i-half+j;
-			switch(mode) {
-			case nsl_smooth_pad_none:
-				/*printf(" %d",index);*/
-				values[j] = data[index];
-				break;
-			case nsl_smooth_pad_interp:
-				printf("not implemented yet\n");
-				break;
-			case nsl_smooth_pad_mirror:
-				index=abs(index);
-				/*printf(" %d",GSL_MIN(index,2*(n-1)-index));*/
-				values[j] = data[GSL_MIN(index,2*(n-1)-index)];
-				break;
-			case nsl_smooth_pad_nearest:
-				/*printf(" %d",GSL_MIN(n-1,GSL_MAX(0,index)));*/
-				values[j] = data[GSL_MIN(n-1,GSL_MAX(0,index))];
-				break;
-			case nsl_smooth_pad_constant:
-				if(index<0)
-					values[j] = nsl_smooth_pad_constant_lvalue;
-				else if(index>(int)n-1)
-					values[j] = nsl_smooth_pad_constant_rvalue;
-				else
-					values[j] = data[index];
-				break;
-			case nsl_smooth_pad_periodic:
-				if(index<0)
-					index = n+index;
-				else if(index>(int)n-1)
-					index = index-n;
-				/*printf(" %d",index);*/
-				values[j] = data[index];
-				break;
-			}
+	/* the whole window inside the signal */
+	const unsigned int cfrom = GSL_MAX(from, points-1);
+	if(cfrom < to) {
+		if(weight == nsl_smooth_weight_uniform)
+			nsl_smooth_running_mean(data, points, points-1, result, cfrom, to);
+		else
+			nsl_smooth_convolve(data, n, w, points, points-1, result, cfrom, to);
+	}
+
+	free(w);
+
+	return 0;
+}
+
+/* node of the order statistic tree (treap) over the values of a window */
+typedef struct {
+	double value;
+	size_t index;	/* position of the value, orders equal values */
+	unsigned int priority;
+	int left, right;	/* children, -1 if none */
+	unsigned int size;	/* number of nodes in the subtree */
+} nsl_smooth_tree_node;
+
+static unsigned int nsl_smooth_tree_size(const nsl_smooth_tree_node *nodes, int t) {
+	return t < 0 ? 0 : nodes[t].size;
+}
+
+static void nsl_smooth_tree_update(nsl_smooth_tree_node *nodes, int t) {
+	nodes[t].size = 1+nsl_smooth_tree_size(nodes, nodes[t].left)+nsl_smooth_tree_size(nodes, nodes[t].right);
+}
+
+/* is node a before node b */
+static int nsl_smooth_tree_less(const nsl_smooth_tree_node *nodes, int a, int b) {
+	if(nodes[a].value != nodes[b].value)
+		return nodes[a].value < nodes[b].value;
+	return nodes[a].index < nodes[b].index;
+}
+
+/* split the tree t into the nodes before node k (l) and the other nodes (r) */
+static void nsl_smooth_tree_split(nsl_smooth_tree_node *nodes, int t, int k, int *l, int *r) {
+	if(t < 0) {
+		*l = *r = -1;
+		return;
+	}
+	if(nsl_smooth_tree_less(nodes, t, k)) {
+		nsl_smooth_tree_split(nodes, nodes[t].right, k, &nodes[t].right, r);
+		*l = t;
+	} else {
+		nsl_smooth_tree_split(nodes, nodes[t].left, k, l, &nodes[t].left);
+		*r = t;
+	}
+	nsl_smooth_tree_update(nodes, t);
+}
+
+/* merge the trees l and r, all nodes of l are before the nodes of r */
+static int nsl_smooth_tree_merge(nsl_smooth_tree_node *nodes, int l, int r) {
+	if(l < 0)
+		return r;
+	if(r < 0)
+		return l;
+	if(nodes[l].priority > nodes[r].priority) {
+		nodes[l].right = nsl_smooth_tree_merge(nodes, nodes[l].right, r);
+		nsl_smooth_tree_update(nodes, l);
+		return l;
+	}
+	nodes[r].left = nsl_smooth_tree_merge(nodes, l, nodes[r].left);
+	nsl_smooth_tree_update(nodes, r);
+	return r;
+}
+
+/* insert node k into the tree t, returns the new root */
+static int nsl_smooth_tree_insert(nsl_smooth_tree_node *nodes, int t, int k) {
+	int l, r;
+	nodes[k].left = nodes[k].right = -1;
+	nodes[k].size = 1;
+	nsl_smooth_tree_split(nodes, t, k, &l, &r);
+	return nsl_smooth_tree_merge(nodes, nsl_smooth_tree_merge(nodes, l, k), r);
+}
+
+/* remove node k from the tree t, returns the new root */
+static int nsl_smooth_tree_remove(nsl_smooth_tree_node *nodes, int t, int k) {
+	if(t == k)
+		return nsl_smooth_tree_merge(nodes, nodes[t].left, nodes[t].right);
+	if(nsl_smooth_tree_less(nodes, k, t))
+		nodes[t].left = nsl_smooth_tree_remove(nodes, nodes[t].left, k);
+	else
+		nodes[t].right = nsl_smooth_tree_remove(nodes, nodes[t].right, k);
+	nsl_smooth_tree_update(nodes, t);
+	return t;
+}
+
+/* (k+1)-th smallest value of the tree t */
+static double nsl_smooth_tree_select(const nsl_smooth_tree_node *nodes, int t, unsigned int k) {
+	for(;;) {
+		const unsigned int s = nsl_smooth_tree_size(nodes, nodes[t].left);
+		if(k == s)
+			return nodes[t].value;
+		if(k < s)
+			t = nodes[t].left;
+		else {
+			k -= s+1;
+			t = nodes[t].right;
 		}
-		/*puts("");*/
+	}
+}
 
-		/*using type 4 as default */
-		result[i] = nsl_stats_quantile(values, 1, np, percentile, nsl_stats_quantile_type4);
-		free(values);
+/* The window is an order statistic tree (treap) of its at most points values with O(log points) insertion,
+ * removal and selection. The node of the value at position k is k % points. */
+int nsl_smooth_percentile_range(const double *data, unsigned int n, unsigned int points, double percentile, nsl_smooth_pad_mode mode,
+		double *result, unsigned int from, unsigned int to) {
+	unsigned int i;
+	if(points < 1)
+		return -1;
+	if(mode == nsl_smooth_pad_interp) {
+		printf("not implemented yet\n");
+		return -1;
 	}
+	if(from >= to)
+		return 0;
+
+	/* the window of i is data[i-half], ..., data[i+right] (points values) */
+	const unsigned int half = (points-1)/2, right = points-1-half;
+	/* position of the first value of all windows */
+	int first = (int)from-(int)half;
+	if(mode == nsl_smooth_pad_none)
+		first = GSL_MAX(first, 0);
+
+	nsl_smooth_tree_node *nodes = (nsl_smooth_tree_node *)malloc(points*sizeof(nsl_smooth_tree_node));
+	int root = -1;
+
+	/* current window [lo, hi) of positions relative to first */
+	size_t lo = 0, hi = 0;
+	for(i=from;i<to;i++) {
+		unsigned int h = half, r = right;
+		if(mode == nsl_smooth_pad_none) /* reduce points to 2*h+1 */
+			h = r = GSL_MIN(GSL_MIN(half,i),n-i-1);
+		const size_t wlo = i-h-first, whi = i+r-first+1;
+		const unsigned int np = h+r+1;
+
+		/* remove first, so that the nodes of the window are distinct */
+		for(; lo < wlo; lo++)
+			if(lo < hi)
+				root = nsl_smooth_tree_remove(nodes, root, lo % points);
+		if(hi < lo)
+			hi = lo;
+		for(; hi < whi; hi++) {
+			const int k = hi % points;
+			nodes[k].value = nsl_smooth_pad_value(data, n, first+(int)hi, mode);
+			nodes[k].index = hi;
+			/* pseudo random priority (integer hash of the position) */
+			unsigned int p = (unsigned int)hi;
+			p = ((p >> 16) ^ p)*0x45d9f3b;
+			p = ((p >> 16) ^ p)*0x45d9f3b;
+			nodes[k].priority = (p >> 16) ^ p;
+			root = nsl_smooth_tree_insert(nodes, root, k);
+		}
 
-	for (i=0; i<n; i++)
-		data[i]=result[i];
-	free(result);
+		/* type 4 quantile (see nsl_stats_quantile_sorted()) */
+		if(percentile < 1./np)
+			result[i] = nsl_smooth_tree_select(nodes, root, 0);
+		else if(percentile == 1.0)
+			result[i] = nsl_smooth_tree_select(nodes, root, np-1);
+		else {
+			const int j = floor(np*percentile);
+			const double low = nsl_smooth_tree_select(nodes, root, j-1);
+			const double high = nsl_smooth_tree_select(nodes, root, j);
+			result[i] = low+(np*percentile-j)*(high-low);
+		}
+	}
+
+	free(nodes);
 
 	return 0;
 }
 
+int nsl_smooth_percentile(double *data, unsigned int n, unsigned int points, double percentile, nsl_smooth_pad_mode mode) {
+	unsigned int i;
+	double *result = (double *)malloc(n*sizeof(double));
+	int status = nsl_smooth_percentile_range(data, n, points, percentile, mode, result, 0, n);
+
+	if (status == 0)
+		for (i=0; i<n; i++)
+			data[i]=result[i];
+	free(result);
+
+	return status;
+}
+
 int nsl_smooth_savgol_coeff(int points, int order, gsl_matrix *h) {
+	return nsl_smooth_savgol_coeff_deriv(points, order, 0, h);
+}
+
+int nsl_smooth_savgol_coeff_deriv(int points, int order, int deriv, gsl_matrix *h) {
 	int i, j, error = 0;
 
 	/* compute Vandermonde matrix */
@@ -364,6 +617,22 @@ int nsl_smooth_savgol_coeff(int points, int order, gsl_matrix *h) {
 			gsl_matrix_set(vandermonde, i, j, gsl_matrix_get(vandermonde,i,j-1) * i);
 	}
 
+	/* derivatives of the rows of the Vandermonde matrix: d^deriv/di^deriv i^j */
+	gsl_matrix *dvandermonde = vandermonde;
+	if (deriv > 0) {
+		dvandermonde = gsl_matrix_calloc(points, order+1);
+		for (i = 0; i < points; ++i)
+			for (j = deriv; j <= order; ++j) {
+				int k;
+				double value = 1.0;
+				for (k = 0; k < deriv; ++k)
+					value *= j-k;
+				for (k = 0; k < j-deriv; ++k)
+					value *= i;
+				gsl_matrix_set(dvandermonde, i, j, value);
+			}
+	}
+
 	/* compute V^TV */
 	gsl_matrix *vtv = gsl_matrix_alloc(order+1, order+1);
 	error = gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, vandermonde, vandermonde, 0.0, vtv);
@@ -383,8 +652,8 @@ int nsl_smooth_savgol_coeff(int points, int order, gsl_matrix *h) {
 				error = gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, vtv_inv, vandermonde, 0.0, vtv_inv_vt);
 
 				if (!error) {
-					/* finally, compute H = V(V^TV)^(-1)V^T */
-					error = gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, vandermonde, vtv_inv_vt, 0.0, h);
+					/* finally, compute H = V(V^TV)^(-1)V^T (V' instead of V for derivatives) */
+					error = gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, dvandermonde, vtv_inv_vt, 0.0, h);
 				}
 				gsl_matrix_free(vtv_inv_vt);
 			}
@@ -393,6 +662,8 @@ int nsl_smooth_savgol_coeff(int points, int order, gsl_matrix *h) {
 		gsl_permutation_free(p);
 	}
 	gsl_matrix_free(vtv);
+	if (dvandermonde != vandermonde)
+		gsl_matrix_free(dvandermonde);
 	gsl_matrix_free(vandermonde);
 
 	return error;
@@ -403,7 +674,107 @@ void nsl_smooth_pad_constant_set(double lvalue, double rvalue) {
 	nsl_smooth_pad_constant_rvalue = rvalue;
 }
 
+/* Savitzky-Golay coefficients of the last used parameters */
+typedef struct {
+	unsigned int points, order, deriv;
+	gsl_matrix *h;		/* coefficient matrix, NULL if the entry is unused */
+	double *reduced;	/* central rows of the reduced coefficient matrices used at the edges with nsl_smooth_pad_none:
+				   row i (of length 2*i+1) starts at reduced[i*i]. NULL if not calculated yet */
+} nsl_smooth_savgol_cache_entry;
+
+static nsl_smooth_savgol_cache_entry nsl_smooth_savgol_cache[NSL_SMOOTH_SAVGOL_CACHE_SIZE];
+static unsigned int nsl_smooth_savgol_cache_next = 0;
+
+void nsl_smooth_savgol_cache_clear() {
+	unsigned int i;
+	for (i = 0; i < NSL_SMOOTH_SAVGOL_CACHE_SIZE; i++) {
+		nsl_smooth_savgol_cache_entry *entry = &nsl_smooth_savgol_cache[i];
+		if (entry->h)
+			gsl_matrix_free(entry->h);
+		free(entry->reduced);
+		entry->h = NULL;
+		entry->reduced = NULL;
+	}
+	nsl_smooth_savgol_cache_next = 0;
+}
+
+/* cached coefficients for (points, order, deriv) including the reduced coefficients if requested. Returns NULL on error */
+static const nsl_smooth_savgol_cache_entry* nsl_smooth_savgol_cached_coeff(unsigned int points, unsigned int order, unsigned int deriv, int reduced, int *error) {
+	unsigned int i, k;
+	nsl_smooth_savgol_cache_entry *entry = NULL;
+	*error = 0;
+
+	for (i = 0; i < NSL_SMOOTH_SAVGOL_CACHE_SIZE; i++) {
+		nsl_smooth_savgol_cache_entry *e = &nsl_smooth_savgol_cache[i];
+		if (e->h && e->points == points && e->order == order && e->deriv == deriv) {
+			entry = e;
+			break;
+		}
+	}
+
+	if (!entry) {	/* replace the oldest entry */
+		entry = &nsl_smooth_savgol_cache[nsl_smooth_savgol_cache_next];
+		nsl_smooth_savgol_cache_next = (nsl_smooth_savgol_cache_next+1) % NSL_SMOOTH_SAVGOL_CACHE_SIZE;
+		if (entry->h)
+			gsl_matrix_free(entry->h);
+		free(entry->reduced);
+		entry->reduced = NULL;
+
+		entry->h = gsl_matrix_alloc(points, points);
+		*error = nsl_smooth_savgol_coeff_deriv(points, order, deriv, entry->h);
+		if (*error) {
+			gsl_matrix_free(entry->h);
+			entry->h = NULL;
+			return NULL;
+		}
+		entry->points = points;
+		entry->order = order;
+		entry->deriv = deriv;
+	}
+
+	if (reduced && !entry->reduced) {
+		const unsigned int half = (points-1)/2;
+		entry->reduced = (double *)malloc(half*half*sizeof(double));
+		for (i = 0; i < half; i++) {
+			/*reduce points and order*/
+			unsigned int rpoints=2*i+1, rorder=GSL_MIN(order,rpoints-GSL_MIN(rpoints,2));
+
+			gsl_matrix *rh = gsl_matrix_alloc(rpoints, rpoints);
+			*error = nsl_smooth_savgol_coeff_deriv(rpoints, rorder, deriv, rh);
+			if (*error) {
+				gsl_matrix_free(rh);
+				free(entry->reduced);
+				entry->reduced = NULL;
+				return NULL;
+			}
+			for (k = 0; k < rpoints; k++)
+				entry->reduced[i*i+k] = gsl_matrix_get(rh, i, k);
+			gsl_matrix_free(rh);
+		}
+	}
+
+	return entry;
+}
+
 int nsl_smooth_savgol(double *data, unsigned int n, unsigned int points, unsigned int order, nsl_smooth_pad_mode mode) {
+	return nsl_smooth_savgol_deriv(data, n, points, order, 0, mode);
+}
+
+int nsl_smooth_savgol_deriv(double *data, unsigned int n, unsigned int points, unsigned int order, unsigned int deriv, nsl_smooth_pad_mode mode) {
+	unsigned int i;
+	double *result = (double *)malloc(n*sizeof(double));
+	int status = nsl_smooth_savgol_range(data, n, points, order, deriv, mode, result, 0, n);
+
+	if (status == 0)
+		for (i=0; i<n; i++)
+			data[i]=result[i];
+	free(result);
+
+	return status;
+}
+
+int nsl_smooth_savgol_range(const double *data, unsigned int n, unsigned int points, unsigned int order, unsigned int deriv, nsl_smooth_pad_mode mode,
+		double *result, unsigned int from, unsigned int to) {
 	unsigned int i,k;
 	int error=0;
 	unsigned int half=(points-1)/2;	/* n//2 */
@@ -418,116 +789,51 @@ int nsl_smooth_savgol(double *data, unsigned int n, unsigned int points, unsigne
 	}
 
 	/* Savitzky-Golay coefficient matrix, y' = H y */
-	gsl_matrix *h = gsl_matrix_alloc(points, points);
-	error = nsl_smooth_savgol_coeff(points, order, h);
+	const nsl_smooth_savgol_cache_entry *coeff = nsl_smooth_savgol_cached_coeff(points, order, deriv, mode == nsl_smooth_pad_none, &error);
 	if (error) {
 		printf("Internal error in Savitzky-Golay algorithm:\n%s",gsl_strerror(error));
-		gsl_matrix_free(h);
 		return error;
 	}
+	const gsl_matrix *h = coeff->h;
+	/* central row of h */
+	const double *hc = gsl_matrix_const_ptr(h, half, 0);
+	/* central part */
+	const unsigned int cfrom = GSL_MAX(from, half), cto = GSL_MIN(to, n-half);
+
+	/* edges */
+	for (i=from; i<to; i++) {
+		if (i == cfrom && cfrom < cto) {	/* skip the central part */
+			i = cto-1;
+			continue;
+		}
 
-	double *result = (double *)malloc(n*sizeof(double));
-	for (i=0; i<n; i++)
 		result[i]=0;
-
-	/* left edge */
-	if(mode == nsl_smooth_pad_none) {
-		for (i=0; i<half; i++) {
-			/*reduce points and order*/
-			unsigned int rpoints=2*i+1, rorder=GSL_MIN(order,rpoints-GSL_MIN(rpoints,2));
-
-			gsl_matrix *rh = gsl_matrix_alloc(rpoints, rpoints);
-			error = nsl_smooth_savgol_coeff(rpoints, rorder, rh);
-			if (error) {
-				printf("Internal error in Savitzky-Golay algorithm:\n%s",gsl_strerror(error));
-				gsl_matrix_free(rh);
-				return error;
-			}
-			
-			for (k=0; k<rpoints; k++)
-				result[i] += gsl_matrix_get(rh, i, k) * data[k];
+		switch(mode) {
+		case nsl_smooth_pad_none: {
+			/* central row of the reduced matrix */
+			const unsigned int rhalf = GSL_MIN(i,n-1-i);
+			const double *rhc = coeff->reduced+rhalf*rhalf;
+			for (k=0; k<2*rhalf+1; k++)
+				result[i] += rhc[k] * data[i-rhalf+k];
+			break;
 		}
-	} else {
-		for (i=0; i<half; i++) {
-			for (k=0; k<points; k++)
-				switch(mode) {
-				case nsl_smooth_pad_interp:
+		case nsl_smooth_pad_interp:
+			if (i < half)
+				for (k=0; k<points; k++)
 					result[i] += gsl_matrix_get(h, i, k) * data[k];
-					break;
-				case nsl_smooth_pad_mirror:
-					result[i] += gsl_matrix_get(h, half, k) * data[abs(k+i-half)];
-					break;
-				case nsl_smooth_pad_nearest:
-					result[i] += gsl_matrix_get(h, half, k) * data[i+k-GSL_MIN(half,i+k)];
-					break;
-				case nsl_smooth_pad_constant:
-					if (k<half-i)
-						result[i] += gsl_matrix_get(h, half, k) * nsl_smooth_pad_constant_lvalue;
-					else
-						result[i] += gsl_matrix_get(h, half, k) * data[i-half+k];
-					break;
-				case nsl_smooth_pad_periodic:
-					result[i] += gsl_matrix_get(h, half, k) * data[k<half-i?n+i+k-half:i-half+k];
-				default:
-					break;
-				}
-		}
-	}
-
-	/* central part: convolve with fixed row of h */
-	for (i=half; i<n-half; i++)
-		for (k=0; k<points; k++)
-			result[i] += gsl_matrix_get(h, half, k) * data[i-half+k];
-
-	/* right edge */
-	if(mode == nsl_smooth_pad_none) {
-		for (i=n-half; i<n; i++) {
-			/*reduce points and order*/
-			unsigned int rpoints=2*(n-1-i)+1, rorder=GSL_MIN(order,rpoints-GSL_MIN(2,rpoints));
-
-			gsl_matrix *rh = gsl_matrix_alloc(rpoints, rpoints);
-			error = nsl_smooth_savgol_coeff(rpoints, rorder, rh);
-			if (error) {
-				printf("Internal error in Savitzky-Golay algorithm:\n%s",gsl_strerror(error));
-				gsl_matrix_free(rh);
-				return error;
-			}
-			
-			for (k=0; k<rpoints; k++)
-				result[i] += gsl_matrix_get(rh, n-1-i, k) * data[n-rpoints+k];
-		}
-	} else {
-		for (i=n-half; i<n; i++) {
-			for (k=0; k<points; k++)
-				switch(mode) {
-				case nsl_smooth_pad_interp:
+			else
+				for (k=0; k<points; k++)
 					result[i] += gsl_matrix_get(h, points-n+i, k) * data[n-points+k];
-					break;
-				case nsl_smooth_pad_mirror:
-					result[i] += gsl_matrix_get(h, half, k) * data[n-1-abs(k+1+i-n-half)];
-					break;
-				case nsl_smooth_pad_nearest:
-					result[i] += gsl_matrix_get(h, half, k) * data[GSL_MIN(i-half+k,n-1)];
-					break;
-				case nsl_smooth_pad_constant:
-					if (k < n-i+half)
-						result[i] += gsl_matrix_get(h, half, k) * data[i-half+k];
-					else
-						result[i] += gsl_matrix_get(h, half, k) * nsl_smooth_pad_constant_rvalue;
-					break;
-				case nsl_smooth_pad_periodic:
-					result[i] += gsl_matrix_get(h, half, k) * data[(i-half+k) % n];
-				default:
-					break;
-				}
+			break;
+		default:
+			for (k=0; k<points; k++)
+				result[i] += hc[k] * nsl_smooth_pad_value(data, n, (int)(i+k)-(int)half, mode);
 		}
 	}
 
-	gsl_matrix_free(h);
-
-	for (i=0; i<n; i++)
-		data[i]=result[i];
-	free(result);
+	/* central part: convolve with fixed row of h */
+	if (cfrom < cto)
+		nsl_smooth_convolve(data, n, hc, points, half, result, cfrom, cto);
 
 	return 0;
 }
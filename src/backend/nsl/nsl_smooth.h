@@ -50,14 +50,28 @@ extern double nsl_smooth_pad_constant_lvalue, nsl_smooth_pad_constant_rvalue;
 
 /********* Smoothing algorithms **********/
 
-/* Moving average */
+/* The *_range() variants smooth the signal data of length n without modifying it and write the results
+ * from..to-1 into result. The results don't depend on the range, so a long signal can be smoothed in blocks
+ * (e.g. in parallel) giving the same output as smoothing it at once. An empty range only checks the parameters.
+ */
+
+/* Moving average
+ *	uniform weights are calculated with running sums in O(n), the other weights are tabulated once
+ *	and convolved with the signal (via FFT for large windows)
+ */
 int nsl_smooth_moving_average(double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode);
+int nsl_smooth_moving_average_range(const double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode,
+		double *result, unsigned int from, unsigned int to);
 
 /* Lagged moving average */
 int nsl_smooth_moving_average_lagged(double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode);
+int nsl_smooth_moving_average_lagged_range(const double *data, unsigned int n, unsigned int points, nsl_smooth_weight_type weight, nsl_smooth_pad_mode mode,
+		double *result, unsigned int from, unsigned int to);
 
 /* Percentile filter */
 int nsl_smooth_percentile(double *data, unsigned int n, unsigned int points, double percentile, nsl_smooth_pad_mode mode);
+int nsl_smooth_percentile_range(const double *data, unsigned int n, unsigned int points, double percentile, nsl_smooth_pad_mode mode,
+		double *result, unsigned int from, unsigned int to);
 
 /* Savitzky-Golay coefficents */
 /**
@@ -75,6 +89,13 @@ int nsl_smooth_percentile(double *data, unsigned int n, unsigned int points, dou
  * http://www.statistics4u.info/fundstat_eng/cc_filter_savgol_math.html
  */
 int nsl_smooth_savgol_coeff(int points, int order, gsl_matrix *h);
+/**
+ * \brief Compute the coefficients of the #deriv-th derivative of the Savitzky-Golay polynomial.
+ *
+ * The derivative is taken with respect to the point index, i.e. it has to be divided by
+ * \$\Delta x^{deriv}\$ for a sample spacing \$\Delta x\$. For #deriv=0 this is nsl_smooth_savgol_coeff().
+ */
+int nsl_smooth_savgol_coeff_deriv(int points, int order, int deriv, gsl_matrix *h);
 
 /* set values for constant padding */
 void nsl_smooth_pad_constant_set(double lvalue, double rvalue);
@@ -90,6 +111,21 @@ void nsl_smooth_pad_constant_set(double lvalue, double rvalue);
  */
 int nsl_smooth_savgol(double *data, unsigned int n, unsigned int points, unsigned int order, nsl_smooth_pad_mode mode);
 
+/**
+ * \brief Savitzky-Golay smoothing returning the #deriv-th derivative (with respect to the point index).
+ *
+ * The coefficients of the last used parameter sets (points, order, deriv) are cached, so repeated
+ * smoothing with the same parameters only costs the convolution. The cache is not thread-safe, but once
+ * the coefficients are cached (e.g. by calling nsl_smooth_savgol_range() with an empty range) further calls
+ * with the same parameters only read them and can run concurrently.
+ */
+int nsl_smooth_savgol_deriv(double *data, unsigned int n, unsigned int points, unsigned int order, unsigned int deriv, nsl_smooth_pad_mode mode);
+int nsl_smooth_savgol_range(const double *data, unsigned int n, unsigned int points, unsigned int order, unsigned int deriv, nsl_smooth_pad_mode mode,
+		double *result, unsigned int from, unsigned int to);
+
+/* free the cached Savitzky-Golay coefficients */
+void nsl_smooth_savgol_cache_clear();
+
 /* Savitzky-Golay default smooting (interp) */
 int nsl_smooth_savgol_default(double *data, unsigned int n, unsigned int points, unsigned int order);
 
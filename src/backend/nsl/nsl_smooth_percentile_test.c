@@ -62,5 +62,18 @@ int main() {
 	status = nsl_smooth_percentile(data5, 9, points, percentile, nsl_smooth_pad_periodic);
 	for(i=0;i<9;i++)
 		printf(" %g",data5[i]);
+
+	/* even number of points: the window of i is data[i-1], ..., data[i+2] (data[i-1], data[i], data[i+1] for pad_none) */
+	points=4;
+	nsl_smooth_pad_mode mode;
+	for(mode=nsl_smooth_pad_none;mode<=nsl_smooth_pad_periodic;mode++) {
+		if(mode == nsl_smooth_pad_interp)
+			continue;
+		double data6[9]={2,2,5,2,1,0,1,4,9};
+		status = nsl_smooth_percentile(data6, 9, points, percentile, mode);
+		printf("\npoints=%d, mode=%d\n", points, mode);
+		for(i=0;i<9;i++)
+			printf(" %g",data6[i]);
+	}
 	puts("");
 }
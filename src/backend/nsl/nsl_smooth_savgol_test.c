@@ -120,4 +120,22 @@ double main() {
 	for(i=0;i<9;i++)
 		printf(" %7.4f",data5[i]);
 	printf("\n");
+
+	/* derivatives of x^2 (2x and 2) */
+	printf("\n");
+	double data6[9]={0,1,4,9,16,25,36,49,64};
+	printf("first derivative (mode:interp)\n");
+	nsl_smooth_savgol_deriv(data6,9,m,order,1,nsl_smooth_pad_interp);
+	for(i=0;i<9;i++)
+		printf(" %7.4f",data6[i]);
+	printf("\n");
+
+	double data7[9]={0,1,4,9,16,25,36,49,64};
+	printf("second derivative (mode:interp)\n");
+	nsl_smooth_savgol_deriv(data7,9,m,order,2,nsl_smooth_pad_interp);
+	for(i=0;i<9;i++)
+		printf(" %7.4f",data7[i]);
+	printf("\n");
+
+	nsl_smooth_savgol_cache_clear();
 }
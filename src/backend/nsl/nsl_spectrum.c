@@ -0,0 +1,181 @@
+/***************************************************************************
+    File                 : nsl_spectrum.c
+    Project              : LabPlot
+    Description          : NSL power spectrum functions
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "nsl_spectrum.h"
+#include <math.h>
+#include <string.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+
+void nsl_spectrum_window(double* w, size_t n, nsl_spectrum_window_type type) {
+	size_t j;
+	for (j = 0; j < n; j++) {
+		const double x = (double)j/n;
+		switch (type) {
+		case nsl_spectrum_window_rectangular:
+			w[j] = 1.;
+			break;
+		case nsl_spectrum_window_triangular:
+			w[j] = 1. - fabs(2.*x - 1.);
+			break;
+		case nsl_spectrum_window_welch:
+			w[j] = 1. - gsl_pow_2(2.*x - 1.);
+			break;
+		case nsl_spectrum_window_hann:
+			w[j] = 0.5 - 0.5*cos(2.*M_PI*x);
+			break;
+		case nsl_spectrum_window_hamming:
+			w[j] = 0.54 - 0.46*cos(2.*M_PI*x);
+			break;
+		case nsl_spectrum_window_blackman:
+			w[j] = 0.42 - 0.5*cos(2.*M_PI*x) + 0.08*cos(4.*M_PI*x);
+			break;
+		}
+	}
+}
+
+size_t nsl_spectrum_segment_count(size_t n, size_t segment, size_t overlap) {
+	if (segment == 0 || segment > n || overlap >= segment)
+		return 0;
+
+	return (n - segment)/(segment - overlap) + 1;
+}
+
+int nsl_spectrum_segment(nsl_fft_plan* plan, const double* data, const double* w, double wnorm, double* work, double* psd) {
+	const size_t n = nsl_fft_plan_size(plan);
+	size_t k;
+	int status;
+
+	if (w)
+		for (k = 0; k < n; k++)
+			work[k] = w[k]*data[k];
+	else
+		memcpy(work, data, n*sizeof(double));
+
+	status = nsl_fft_real_transform(plan, work);
+	if (status != GSL_SUCCESS)
+		return status;
+
+	/* halfcomplex: r_0, r_1, i_1, ..., (r_n/2 for even n), all bins except 0 and n/2 count twice */
+	psd[0] = gsl_pow_2(work[0])/wnorm;
+	for (k = 1; 2*k < n; k++)
+		psd[k] = 2.*(gsl_pow_2(work[2*k-1]) + gsl_pow_2(work[2*k]))/wnorm;
+	if (n%2 == 0)
+		psd[n/2] = gsl_pow_2(work[n-1])/wnorm;
+
+	return GSL_SUCCESS;
+}
+
+int nsl_spectrum_welch_sum(nsl_fft_plan* plan, const double* data, size_t step, const double* w, double wnorm,
+		size_t first, size_t last, double* work, double* sum) {
+	const size_t bins = nsl_fft_plan_size(plan)/2 + 1;
+	size_t i, k;
+
+	for (i = first; i < last; i++) {
+		/* the spectrum is written over the transformed data in work */
+		int status = nsl_spectrum_segment(plan, data + i*step, w, wnorm, work, work);
+		if (status != GSL_SUCCESS)
+			return status;
+		for (k = 0; k < bins; k++)
+			sum[k] += work[k];
+	}
+
+	return GSL_SUCCESS;
+}
+
+/* allocates the plan and the window for segments of length segment */
+static int nsl_spectrum_setup(size_t segment, nsl_spectrum_window_type type, nsl_fft_plan** plan, double** w, double* wnorm) {
+	size_t j;
+
+	*plan = nsl_fft_plan_alloc(segment);
+	*w = (double*)malloc(2*segment*sizeof(double));
+	if (*plan == NULL || *w == NULL) {
+		nsl_fft_plan_free(*plan);
+		free(*w);
+		return GSL_ENOMEM;
+	}
+
+	nsl_spectrum_window(*w, segment, type);
+	*wnorm = 0;
+	for (j = 0; j < segment; j++)
+		*wnorm += gsl_pow_2((*w)[j]);
+
+	return GSL_SUCCESS;
+}
+
+int nsl_spectrum_welch(const double* data, size_t n, size_t segment, size_t overlap, nsl_spectrum_window_type type, double* psd) {
+	const size_t count = nsl_spectrum_segment_count(n, segment, overlap);
+	const size_t bins = segment/2 + 1;
+	nsl_fft_plan* plan;
+	double *w, wnorm;
+	size_t k;
+	int status;
+
+	if (count == 0)
+		return GSL_EINVAL;
+	status = nsl_spectrum_setup(segment, type, &plan, &w, &wnorm);
+	if (status != GSL_SUCCESS)
+		return status;
+
+	/* w is followed by the work array */
+	for (k = 0; k < bins; k++)
+		psd[k] = 0;
+	status = nsl_spectrum_welch_sum(plan, data, segment - overlap, w, wnorm, 0, count, w + segment, psd);
+	for (k = 0; k < bins; k++)
+		psd[k] /= count;
+
+	nsl_fft_plan_free(plan);
+	free(w);
+
+	return status;
+}
+
+int nsl_spectrum_spectrogram(const double* data, size_t n, size_t segment, size_t overlap, nsl_spectrum_window_type type, double* psd) {
+	const size_t count = nsl_spectrum_segment_count(n, segment, overlap);
+	const size_t bins = segment/2 + 1;
+	nsl_fft_plan* plan;
+	double *w, wnorm;
+	size_t i;
+	int status;
+
+	if (count == 0)
+		return GSL_EINVAL;
+	status = nsl_spectrum_setup(segment, type, &plan, &w, &wnorm);
+	if (status != GSL_SUCCESS)
+		return status;
+
+	for (i = 0; i < count && status == GSL_SUCCESS; i++) {
+		status = nsl_spectrum_segment(plan, data + i*(segment - overlap), w, wnorm, w + segment, w + segment);
+		memcpy(psd + i*bins, w + segment, bins*sizeof(double));
+	}
+
+	nsl_fft_plan_free(plan);
+	free(w);
+
+	return status;
+}
@@ -0,0 +1,68 @@
+/***************************************************************************
+    File                 : nsl_spectrum.h
+    Project              : LabPlot
+    Description          : NSL power spectrum functions
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef NSL_SPECTRUM_H
+#define NSL_SPECTRUM_H
+
+#include <stdlib.h>
+#include "nsl_fft.h"
+
+/* window functions (same order as XYSpectrumCurve::WindowType) */
+typedef enum {nsl_spectrum_window_rectangular, nsl_spectrum_window_triangular, nsl_spectrum_window_welch,
+	nsl_spectrum_window_hann, nsl_spectrum_window_hamming, nsl_spectrum_window_blackman} nsl_spectrum_window_type;
+
+/* All spectra are one-sided power spectral densities in units of the sample rate (fs = 1):
+ * bin k = 0..n/2 of a segment of length n belongs to the frequency k/n and the spectrum
+ * integrates to the mean power of the (windowed) data, i.e. sum_k psd[k]/n = <x^2>.
+ * Divide by the sample rate to get the density per frequency unit.
+ */
+
+/* periodic window of length n (for spectral analysis) in w */
+void nsl_spectrum_window(double* w, size_t n, nsl_spectrum_window_type type);
+
+/* number of segments of length segment with overlap values in n data points (0 if segment > n) */
+size_t nsl_spectrum_segment_count(size_t n, size_t segment, size_t overlap);
+
+/* Spectrum of one segment: the nsl_fft_plan_size(plan) values in data are multiplied with the window w
+ * (rectangular if w is NULL, wnorm = sum of w^2) into work (same size) and transformed.
+ * The size/2+1 values are written to psd, which may be work. */
+int nsl_spectrum_segment(nsl_fft_plan* plan, const double* data, const double* w, double wnorm, double* work, double* psd);
+
+/* Add the spectra of the segments first..last-1 (segment i starts at i*step) to sum (size/2+1 values).
+ * Different ranges can be processed independently, e.g. in parallel with one plan and work array each. */
+int nsl_spectrum_welch_sum(nsl_fft_plan* plan, const double* data, size_t step, const double* w, double wnorm,
+	size_t first, size_t last, double* work, double* sum);
+
+/* Welch's averaged spectrum of the n values in data with segments of length segment overlapping by
+ * overlap values, psd has segment/2+1 values. segment = n and overlap = 0 give the periodogram. */
+int nsl_spectrum_welch(const double* data, size_t n, size_t segment, size_t overlap, nsl_spectrum_window_type type, double* psd);
+
+/* spectrogram: the spectra of all segments, segment i written to psd[i*(segment/2+1)] */
+int nsl_spectrum_spectrogram(const double* data, size_t n, size_t segment, size_t overlap, nsl_spectrum_window_type type, double* psd);
+
+#endif /* NSL_SPECTRUM_H */
@@ -0,0 +1,74 @@
+/***************************************************************************
+    File                 : nsl_spectrum_test.c
+    Project              : LabPlot
+    Description          : NSL power spectrum test
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 by agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "nsl_spectrum.h"
+
+int main() {
+	const size_t n = 64;
+	double data[256], psd[129], sum;
+	size_t i, k;
+
+	/* periodogram of a sine with frequency 1/8: only bin 8 (value n/2), total power 1/2 */
+	for (i = 0; i < n; i++)
+		data[i] = sin(2.*M_PI*i/8.);
+	nsl_spectrum_welch(data, n, n, 0, nsl_spectrum_window_rectangular, psd);
+	sum = 0;
+	for (k = 0; k <= n/2; k++) {
+		printf(" %g", fabs(psd[k]) < 1.e-12 ? 0 : psd[k]);
+		sum += psd[k];
+	}
+	printf("\npower = %g\n", sum/n);
+
+	/* Welch (Hann, segments of 32 overlapping by 16): 15 segments,
+	   0 0 0 2.667 10.67 2.667 0 0.02667 0.1067 0.02667 0 0 0 0 0 0 0 */
+	for (i = 0; i < 256; i++)
+		data[i] = sin(2.*M_PI*i/8.) + 0.1*cos(2.*M_PI*i/4.);
+	printf("segments = %zu\n", nsl_spectrum_segment_count(256, 32, 16));
+	nsl_spectrum_welch(data, 256, 32, 16, nsl_spectrum_window_hann, psd);
+	for (k = 0; k <= 16; k++)
+		printf(" %.4g", fabs(psd[k]) < 1.e-12 ? 0 : psd[k]);
+	printf("\n");
+
+	/* spectrogram: the frequency changes from 1/8 to 1/4 in the middle, the peak moves from bin 2 to bin 4:
+	   2 2 2 2 4 4 4 4 */
+	for (i = 0; i < 128; i++)
+		data[i] = (i < 64) ? sin(2.*M_PI*i/8.) : sin(2.*M_PI*i/4.);
+	nsl_spectrum_spectrogram(data, 128, 16, 0, nsl_spectrum_window_hann, psd);
+	for (i = 0; i < 8; i++) {
+		size_t max = 0;
+		for (k = 1; k <= 8; k++)
+			if (psd[i*9+k] > psd[i*9+max])
+				max = k;
+		printf(" %zu", max);
+	}
+	printf("\n");
+
+	return 0;
+}
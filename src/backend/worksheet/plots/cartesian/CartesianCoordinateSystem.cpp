@@ -228,8 +228,11 @@ public:
 	CartesianCoordinateSystemPrivate(CartesianCoordinateSystem *owner);
 	~CartesianCoordinateSystemPrivate();
 
+	QRectF plotRect() const;
+
 	CartesianCoordinateSystem* const q;
 	CartesianPlot* plot;
+	QRectF pageRect;	//plot rect of the snapshots not connected to the plot anymore, see snapshot()
 	QList<CartesianCoordinateSystem::Scale*> xScales;
 	QList<CartesianCoordinateSystem::Scale*> yScales;
 };
@@ -246,43 +249,9 @@ CartesianCoordinateSystem::~CartesianCoordinateSystem() {
 }
 
 QList<QPointF> CartesianCoordinateSystem::mapLogicalToScene(const QList<QPointF> &points, const MappingFlags &flags) const {
-	const QRectF pageRect = d->plot->plotRect();
 	QList<QPointF> result;
-	bool noPageClipping = pageRect.isNull() || (flags & SuppressPageClipping);
-
-	foreach (const Scale* xScale, d->xScales) {
-		if (!xScale) continue;
-		Interval<double> xInterval;
-		xScale->getProperties(NULL, &xInterval);
-
-		foreach (const Scale* yScale, d->yScales) {
-			if (!yScale) continue;
-			Interval<double> yInterval;
-			yScale->getProperties(NULL, &yInterval);
-
-			foreach(const QPointF& point, points) {
-				double x = point.x();
-				double y = point.y();
-
-				if (!xInterval.fuzzyContains(x))
-					continue;
-
-				if (!yInterval.fuzzyContains(y))
-					continue;
-
-				if (!xScale->map(&x))
-					continue;
-
-				if (!yScale->map(&y))
-					continue;
-
-				const QPointF mappedPoint(x, y);
-				if (noPageClipping || rectContainsPoint(pageRect, mappedPoint))
-					result.append(mappedPoint);
-			}
-		}
-	}
-
+	std::vector<bool> visiblePoints;
+	mapLogicalToScene(points, result, visiblePoints, flags);
 	return result;
 }
 
@@ -297,49 +266,150 @@ void CartesianCoordinateSystem::mapLogicalToScene(const QList<QPointF>& logicalP
 												  QList<QPointF>& scenePoints,
 												  std::vector<bool>& visiblePoints,
 												  const MappingFlags& flags) const{
-	const QRectF pageRect = d->plot->plotRect();
-	QList<QPointF> result;
-	bool noPageClipping = pageRect.isNull() || (flags & SuppressPageClipping);
+	const int n = logicalPoints.size();
+	QVector<double> x(n), y(n), sceneX(n), sceneY(n);
+	for (int i=0; i<n; ++i) {
+		x[i] = logicalPoints.at(i).x();
+		y[i] = logicalPoints.at(i).y();
+	}
+
+	const int count = mapLogicalToScene(x.constData(), y.constData(), n, sceneX.data(), sceneY.data(), visiblePoints, flags);
+	for (int i=0; i<count; ++i)
+		scenePoints.append(QPointF(sceneX.at(i), sceneY.at(i)));
+}
+
+//inline versions of AbstractCoordinateSystem::definitelyLessThan() and definitelyGreaterThan() for the batch mapping
+static inline bool definitelyLessThan(float a, float b) {
+	const float epsilon = 0.0000001;
+	return (b - a) > ( (fabs(a) < fabs(b) ? fabs(b) : fabs(a)) * epsilon);
+}
+
+static inline bool definitelyGreaterThan(float a, float b) {
+	const float epsilon = 0.0000001;
+	return (a - b) > ( (fabs(a) < fabs(b) ? fabs(b) : fabs(a)) * epsilon);
+}
+
+/*!
+	maps the \c n values with the linear or logarithmic scale \c scale to \c result.
+	The scale is evaluated directly instead of calling Scale::map() for every value, so that the loops can be vectorized.
+	Values not defined for the scale (e.g. non-positive values for log scales) become NaN.
+ */
+static void mapScaleValues(const CartesianCoordinateSystem::Scale* scale, const double* values, int n, double* result) {
+	CartesianCoordinateSystem::Scale::ScaleType type;
+	double a, b, c;
+	scale->getProperties(&type, NULL, &a, &b, &c);
+
+	switch (type) {
+	case CartesianCoordinateSystem::Scale::ScaleLinear:
+		for (int i=0; i<n; ++i)
+			result[i] = values[i] * b + a;
+		break;
+	case CartesianCoordinateSystem::Scale::ScaleLog: {
+		const double logBase = log(c);
+		for (int i=0; i<n; ++i)
+			result[i] = (values[i] > 0.0) ? log(values[i])/logBase * b + a : NAN;
+		break;
+	}
+	default:
+		for (int i=0; i<n; ++i) {
+			result[i] = values[i];
+			if (!scale->map(&result[i]))
+				result[i] = NAN;
+		}
+	}
+}
 
+/*!
+	Maps the \c n points in logical coordinates given by the arrays \c x and \c y to scene coordinates.
+	The points inside of the current region of the coordinate system are written to the preallocated
+	arrays \c sceneX and \c sceneY (at least \c n values each) and their entries in \c visiblePoints are set to \c true.
+	The scales are applied to all points at once and the visibility is determined in the same pass.
+	Returns the number of points written to \c sceneX and \c sceneY.
+ */
+int CartesianCoordinateSystem::mapLogicalToScene(const double* x, const double* y, int n, double* sceneX, double* sceneY,
+		std::vector<bool>& visiblePoints, const MappingFlags& flags) const {
+	visiblePoints.assign(n, false);
+	if (n == 0)
+		return 0;
+
+	//page rectangle, see rectContainsPoint()
+	const QRectF pageRect = d->plotRect();
+	const bool noPageClipping = pageRect.isNull() || (flags & SuppressPageClipping);
+	qreal l = pageRect.x();
+	qreal r = pageRect.x();
+	qreal t = pageRect.y();
+	qreal b = pageRect.y();
+	if (pageRect.width() < 0)
+		l += pageRect.width();
+	else
+		r += pageRect.width();
+	if (pageRect.height() < 0)
+		t += pageRect.height();
+	else
+		b += pageRect.height();
+	if (!noPageClipping && (AbstractCoordinateSystem::essentiallyEqual(l, r) || AbstractCoordinateSystem::essentiallyEqual(t, b)))
+		return 0;
+
+	//with one pair of scales the points are mapped directly into the result arrays and compacted afterwards
+	const bool singleScales = (d->xScales.size() == 1 && d->yScales.size() == 1);
+	QVector<double> mappedXVector, mappedYVector;
+	if (!singleScales) {
+		mappedXVector.resize(n);
+		mappedYVector.resize(n);
+	}
+	double* mappedX = singleScales ? sceneX : mappedXVector.data();
+	double* mappedY = singleScales ? sceneY : mappedYVector.data();
+
+	int count = 0;
 	foreach (const Scale* xScale, d->xScales) {
 		if (!xScale) continue;
 		Interval<double> xInterval;
 		xScale->getProperties(NULL, &xInterval);
+		const float xStart = xInterval.start();
+		const float xEnd = xInterval.end();
+		mapScaleValues(xScale, x, n, mappedX);
 
 		foreach (const Scale* yScale, d->yScales) {
 			if (!yScale) continue;
 			Interval<double> yInterval;
 			yScale->getProperties(NULL, &yInterval);
+			const float yStart = yInterval.start();
+			const float yEnd = yInterval.end();
+			mapScaleValues(yScale, y, n, mappedY);
 
-			for (int i=0; i<logicalPoints.size(); ++i) {
-				const QPointF& point = logicalPoints.at(i);
-				double x = point.x();
-				double y = point.y();
+			for (int i=0; i<n; ++i) {
+				if (visiblePoints[i])
+					continue;
 
-				if (!xInterval.fuzzyContains(x))
+				if (!definitelyLessThan(xStart, x[i]) || !definitelyGreaterThan(xEnd, x[i]))
 					continue;
 
-				if (!yInterval.fuzzyContains(y))
+				if (!definitelyLessThan(yStart, y[i]) || !definitelyGreaterThan(yEnd, y[i]))
 					continue;
 
-				if (!xScale->map(&x))
+				const double mx = mappedX[i];
+				const double my = mappedY[i];
+				if (std::isnan(mx) || std::isnan(my))
 					continue;
 
-				if (!yScale->map(&y))
+				if (!noPageClipping && (definitelyLessThan(mx, l) || definitelyGreaterThan(mx, r)
+						|| definitelyLessThan(my, t) || definitelyGreaterThan(my, b)))
 					continue;
 
-				const QPointF mappedPoint(x, y);
-				if (noPageClipping || rectContainsPoint(pageRect, mappedPoint)) {
-					scenePoints.append(mappedPoint);
-					visiblePoints[i].flip();
-				}
+				//count <= i, compacting in place is safe
+				sceneX[count] = mx;
+				sceneY[count] = my;
+				++count;
+				visiblePoints[i] = true;
 			}
 		}
 	}
+
+	return count;
 }
 
 QPointF CartesianCoordinateSystem::mapLogicalToScene(const QPointF& logicalPoint, const MappingFlags& flags) const{
-	const QRectF pageRect = d->plot->plotRect();
+	const QRectF pageRect = d->plotRect();
 	QList<QPointF> result;
 	bool noPageClipping = pageRect.isNull() || (flags & SuppressPageClipping);
 
@@ -377,7 +447,7 @@ QPointF CartesianCoordinateSystem::mapLogicalToScene(const QPointF& logicalPoint
 }
 
 QList<QPointF> CartesianCoordinateSystem::mapSceneToLogical(const QList<QPointF> &points, const MappingFlags &flags) const{
-	QRectF pageRect = d->plot->plotRect();
+	QRectF pageRect = d->plotRect();
 	QList<QPointF> result;
 	bool noPageClipping = pageRect.isNull() || (flags & SuppressPageClipping);
 
@@ -425,7 +495,7 @@ QList<QPointF> CartesianCoordinateSystem::mapSceneToLogical(const QList<QPointF>
 }
 
 QPointF CartesianCoordinateSystem::mapSceneToLogical(const QPointF& logicalPoint, const MappingFlags& flags) const {
-	QRectF pageRect = d->plot->plotRect();
+	QRectF pageRect = d->plotRect();
 	QPointF result;
 	bool noPageClipping = pageRect.isNull() || (flags & SuppressPageClipping);
 
@@ -466,8 +536,18 @@ QPointF CartesianCoordinateSystem::mapSceneToLogical(const QPointF& logicalPoint
 }
 
 QList<QLineF> CartesianCoordinateSystem::mapLogicalToScene(const QList<QLineF> &lines, const MappingFlags &flags) const{
-	QRectF pageRect = d->plot->plotRect();
-	QList<QLineF> result;
+	QVector<QLineF> result;
+	mapLogicalToScene(lines.toVector(), result, flags);
+	return result.toList();
+}
+
+/*!
+	Maps the lines in logical coordinates from \c lines to scene coordinates and appends them to \c result.
+	The lines are clipped to the current region of the coordinate system. Working on vectors,
+	the memory already allocated in \c result is reused.
+ */
+void CartesianCoordinateSystem::mapLogicalToScene(const QVector<QLineF>& lines, QVector<QLineF>& result, const MappingFlags& flags) const{
+	QRectF pageRect = d->plotRect();
 	bool doPageClipping = !pageRect.isNull() && !(flags & SuppressPageClipping);
 
 	double xGapBefore = NAN;
@@ -629,8 +709,6 @@ QList<QLineF> CartesianCoordinateSystem::mapLogicalToScene(const QList<QLineF> &
 			}
 		}
 	}
-
-	return result;
 }
 
 /**
@@ -684,6 +762,33 @@ QList<CartesianCoordinateSystem::Scale *> CartesianCoordinateSystem::yScales() c
 	return d->yScales; // TODO: should rather return a copy of the scales here
 }
 
+/*!
+  returns a copy of this coordinate system with copies of the scales and of the current plot rect.
+  The copy doesn't access the plot anymore and can be used for the mapping in other threads
+  while the plot is changed. The caller takes the ownership of the copy.
+*/
+CartesianCoordinateSystem* CartesianCoordinateSystem::snapshot() const {
+	CartesianCoordinateSystem* copy = new CartesianCoordinateSystem(d->plot);
+	copy->d->plot = 0;
+	copy->d->pageRect = d->plotRect();
+
+	Scale::ScaleType type;
+	Interval<double> interval;
+	double a, b, c;
+	foreach (const Scale* scale, d->xScales) {
+		if (!scale) continue;
+		scale->getProperties(&type, &interval, &a, &b, &c);
+		copy->d->xScales << Scale::createScale(type, interval, a, b, c);
+	}
+	foreach (const Scale* scale, d->yScales) {
+		if (!scale) continue;
+		scale->getProperties(&type, &interval, &a, &b, &c);
+		copy->d->yScales << Scale::createScale(type, interval, a, b, c);
+	}
+
+	return copy;
+}
+
 void CartesianCoordinateSystem::handlePageResize(double horizontalRatio, double verticalRatio) {
 	Scale::ScaleType type;
 	Interval<double> interval;
@@ -754,6 +859,10 @@ CartesianCoordinateSystemPrivate::~CartesianCoordinateSystemPrivate() {
 		delete yScales.takeFirst();
 }
 
+QRectF CartesianCoordinateSystemPrivate::plotRect() const {
+	return plot ? plot->plotRect() : pageRect;
+}
+
 //##############################################################################
 //##################  Serialization/Deserialization  ###########################
 //##############################################################################
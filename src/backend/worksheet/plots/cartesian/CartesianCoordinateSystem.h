@@ -34,6 +34,7 @@
 #include "backend/lib/macros.h"
 #include "backend/lib/Interval.h"
 
+#include <QVector>
 #include <vector>
 
 class CartesianPlot;
@@ -89,10 +90,12 @@ class CartesianCoordinateSystem: public AbstractCoordinateSystem {
 
 		virtual QList<QPointF> mapLogicalToScene(const QList<QPointF>&, const MappingFlags &flags = DefaultMapping) const;
 		void mapLogicalToScene(const QList<QPointF>& logicalPoints, QList<QPointF>& scenePoints, std::vector<bool>& visiblePoints, const MappingFlags& flags = DefaultMapping) const;
+		int mapLogicalToScene(const double* x, const double* y, int n, double* sceneX, double* sceneY, std::vector<bool>& visiblePoints, const MappingFlags& flags = DefaultMapping) const;
 		virtual QPointF mapLogicalToScene(const QPointF&,const MappingFlags& flags = DefaultMapping) const;
 		virtual QList<QPointF> mapSceneToLogical(const QList<QPointF>&, const MappingFlags &flags = DefaultMapping) const;
 		virtual QPointF mapSceneToLogical(const QPointF&, const MappingFlags &flags = DefaultMapping) const;
 		virtual QList<QLineF> mapLogicalToScene(const QList<QLineF>&, const MappingFlags &flags = DefaultMapping) const;
+		void mapLogicalToScene(const QVector<QLineF>& lines, QVector<QLineF>& result, const MappingFlags& flags = DefaultMapping) const;
 
 		virtual void handlePageResize(double horizontalRatio, double verticalRatio);
 
@@ -102,6 +105,7 @@ class CartesianCoordinateSystem: public AbstractCoordinateSystem {
 		QList<Scale *> xScales() const;
 		bool setYScales(const QList<Scale *> &scales);
 		QList<Scale *> yScales() const;
+		CartesianCoordinateSystem* snapshot() const;
 
 		virtual void save(QXmlStreamWriter *) const;
 		virtual bool load(XmlStreamReader *);
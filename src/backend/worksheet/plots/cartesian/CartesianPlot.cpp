@@ -36,6 +36,7 @@
 #include "XYSmoothCurve.h"
 #include "XYFitCurve.h"
 #include "XYFourierFilterCurve.h"
+#include "XYSpectrumCurve.h"
 #include "backend/core/Project.h"
 #include "backend/worksheet/plots/cartesian/CartesianPlotLegend.h"
 #include "backend/worksheet/plots/cartesian/CustomPoint.h"
@@ -349,6 +350,7 @@ void CartesianPlot::initActions() {
 	addEquationCurveAction = new KAction(KIcon("labplot-xy-equation-curve"), i18n("xy-curve from a mathematical equation"), this);
 	addFitCurveAction = new KAction(KIcon("labplot-xy-fit-curve"), i18n("xy-curve from a fit to data"), this);
 	addFourierFilterCurveAction = new KAction(KIcon("labplot-xy-fourier_filter-curve"), i18n("xy-curve from a Fourier filter"), this);
+	addSpectrumCurveAction = new KAction(KIcon("labplot-xy-spectrum-curve"), i18n("xy-curve from a power spectrum"), this);
 	addInterpolationCurveAction = new KAction(KIcon("labplot-xy-interpolation-curve"), i18n("xy-curve from an interpolation"), this);
 	addSmoothCurveAction = new KAction(KIcon("labplot-xy-smooth-curve"), i18n("xy-curve from a smooth"), this);
 	addLegendAction = new KAction(KIcon("text-field"), i18n("legend"), this);
@@ -360,6 +362,7 @@ void CartesianPlot::initActions() {
 	connect(addEquationCurveAction, SIGNAL(triggered()), SLOT(addEquationCurve()));
 	connect(addFitCurveAction, SIGNAL(triggered()), SLOT(addFitCurve()));
 	connect(addFourierFilterCurveAction, SIGNAL(triggered()), SLOT(addFourierFilterCurve()));
+	connect(addSpectrumCurveAction, SIGNAL(triggered()), SLOT(addSpectrumCurve()));
 	connect(addLegendAction, SIGNAL(triggered()), SLOT(addLegend()));
 	connect(addHorizontalAxisAction, SIGNAL(triggered()), SLOT(addHorizontalAxis()));
 	connect(addVerticalAxisAction, SIGNAL(triggered()), SLOT(addVerticalAxis()));
@@ -406,6 +409,7 @@ void CartesianPlot::initMenus() {
 	addNewMenu->addAction(addEquationCurveAction);
 	addNewMenu->addAction(addFitCurveAction);
 	addNewMenu->addAction(addFourierFilterCurveAction);
+	addNewMenu->addAction(addSpectrumCurveAction);
 	addNewMenu->addAction(addLegendAction);
 	addNewMenu->addSeparator();
 	addNewMenu->addAction(addHorizontalAxisAction);
@@ -735,6 +739,12 @@ XYFourierFilterCurve* CartesianPlot::addFourierFilterCurve() {
 	return curve;
 }
 
+XYSpectrumCurve* CartesianPlot::addSpectrumCurve() {
+	XYSpectrumCurve* curve = new XYSpectrumCurve("Spectrum");
+	this->addChild(curve);
+	return curve;
+}
+
 void CartesianPlot::addLegend() {
 	//don't do anything if there's already a legend
 	if (m_legend)
@@ -2023,6 +2033,12 @@ bool CartesianPlot::load(XmlStreamReader* reader) {
 				removeChild(curve);
 				return false;
 			}
+		} else if (reader->name() == "xySpectrumCurve") {
+			XYSpectrumCurve* curve = addSpectrumCurve();
+			if (!curve->load(reader)) {
+				removeChild(curve);
+				return false;
+			}
 		} else if (reader->name() == "xyInterpolationCurve") {
 			XYInterpolationCurve* curve = addInterpolationCurve();
 			if (!curve->load(reader)) {
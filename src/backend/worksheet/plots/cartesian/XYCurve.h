@@ -79,6 +79,7 @@ class XYCurve: public WorksheetElement {
 
 		BASIC_D_ACCESSOR_DECL(Symbol::Style, symbolsStyle, SymbolsStyle)
 		BASIC_D_ACCESSOR_DECL(qreal, symbolsOpacity, SymbolsOpacity)
+		BASIC_D_ACCESSOR_DECL(int, symbolsDensityThreshold, SymbolsDensityThreshold)
 		BASIC_D_ACCESSOR_DECL(qreal, symbolsRotationAngle, SymbolsRotationAngle)
 		BASIC_D_ACCESSOR_DECL(qreal, symbolsSize, SymbolsSize)
 		CLASS_D_ACCESSOR_DECL(QBrush, symbolsBrush, SymbolsBrush)
@@ -134,6 +135,8 @@ class XYCurve: public WorksheetElement {
 		virtual void handlePageResize(double horizontalRatio, double verticalRatio);
 
 	private slots:
+		void handleSourceDataChanged();
+		void applyGeometry();
 		void updateValues();
 		void updateErrorBars();
 		void xColumnAboutToBeRemoved(const AbstractAspect*);
@@ -193,12 +196,14 @@ class XYCurve: public WorksheetElement {
 		friend class XYCurveSetSymbolsSizeCmd;
 		friend class XYCurveSetSymbolsRotationAngleCmd;
 		friend class XYCurveSetSymbolsOpacityCmd;
+		friend class XYCurveSetSymbolsDensityThresholdCmd;
 		friend class XYCurveSetSymbolsBrushCmd;
 		friend class XYCurveSetSymbolsPenCmd;
 		void symbolsStyleChanged(Symbol::Style);
 		void symbolsSizeChanged(qreal);
 		void symbolsRotationAngleChanged(qreal);
 		void symbolsOpacityChanged(qreal);
+		void symbolsDensityThresholdChanged(int);
 		void symbolsBrushChanged(QBrush);
 		void symbolsPenChanged(const QPen&);
 
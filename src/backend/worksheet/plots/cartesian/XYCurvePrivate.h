@@ -29,13 +29,60 @@
 #ifndef XYCURVEPRIVATE_H
 #define XYCURVEPRIVATE_H
 
+#include <QFutureWatcher>
+#include <QThreadPool>
+#include <QHash>
 #include <vector>
+extern "C" {
+#include <gsl/gsl_spline.h>
+}
 
 class CartesianPlot;
+class CartesianCoordinateSystem;
+
+//! tile of the curve rasterized for the screen, see XYCurvePrivate::drawTiles()
+struct XYCurveTile {
+	XYCurveTile() : lastUse(0) {}
+	QPixmap pixmap;
+	quint64 lastUse;	//number of the call of drawTiles() the tile was last drawn in
+};
+
+//! points and lines of a large curve calculated in a worker thread from a snapshot of the data, see XYCurvePrivate::retransformAsync()
+class XYCurveGeometry {
+	public:
+		XYCurveGeometry();
+		~XYCurveGeometry();
+
+		void calculate();
+
+		//snapshot
+		QVector<double> xData;	//values of the source columns, implicitly shared with the columns
+		QVector<double> yData;
+		CartesianCoordinateSystem* cSystem;	//copy of the coordinate system of the plot
+		XYCurve::LineType lineType;
+		bool lineSkipGaps;
+		bool appendable;
+		quint64 xColumnRevision;
+		quint64 yColumnRevision;
+
+		//result
+		QVector<double> pointsLogicalX;
+		QVector<double> pointsLogicalY;
+		QVector<double> pointsSceneX;
+		QVector<double> pointsSceneY;
+		std::vector<bool> visiblePoints;
+		std::vector<bool> connectedPoints;
+		int takenOverRows;
+		bool linesCalculated;	//false for the spline line types calculated in the GUI thread
+		QVector<QLineF> lines;
+		QPainterPath linePath;
+		bool lineDecimated;
+};
 
 class XYCurvePrivate: public QGraphicsItem {
 	public:
 		explicit XYCurvePrivate(XYCurve *owner);
+		~XYCurvePrivate();
 
 		QString name() const;
 		virtual QRectF boundingRect() const;
@@ -50,21 +97,68 @@ class XYCurvePrivate: public QGraphicsItem {
 		QImage m_selectionEffectImage;
 		bool m_hoverEffectImageIsDirty;
 		bool m_selectionEffectImageIsDirty;
+		bool m_decimatedBeforePrinting;
+		bool m_appendable;	//true if rows appended to the source columns can be added, see retransformAppended()
+		int m_takenOverRows;	//number of rows of the source columns taken over up to the last valid row
+		quint64 m_xColumnRevision;	//revisions of the source columns the points were taken over for
+		quint64 m_yColumnRevision;
+		QPixmap m_symbolSprite;	//symbol rendered once for the screen, see symbolSprite()
+		QPoint m_symbolSpriteOffset;	//position of the top left corner of the sprite relative to the symbol center in pixels
+		Symbol::Style m_symbolSpriteStyle;	//style, size, rotation angle, pen, brush and scaling the sprite was rendered for
+		qreal m_symbolSpriteSize;
+		qreal m_symbolSpriteRotationAngle;
+		QPen m_symbolSpritePen;
+		QBrush m_symbolSpriteBrush;
+		qreal m_symbolSpriteScale;
+		QImage m_densityImage;	//density of the visible points drawn instead of the symbols, see updateDensityImage()
+		QRectF m_densityImageRect;	//rect of the density image in scene coordinates
+		qreal m_densityImageScale;	//painter scaling the density image was calculated for
+		bool m_densityImageIsDirty;
+		QThreadPool m_geometryThreadPool;	//runs the calculation of m_geometry, separate from the global thread pool
+		QFutureWatcher<XYCurveGeometry*> m_geometryWatcher;
+		XYCurveGeometry* m_geometry;	//geometry calculated in the worker thread, shown after applyGeometry()
+		bool m_geometryPending;	//true if the curve was changed again during the calculation of m_geometry
+		QHash<QPair<int, int>, XYCurveTile> m_tiles;	//curve rasterized for the screen, see drawTiles()
+		qreal m_tilesScaleX;	//scaling of the painter the tiles were rasterized for
+		qreal m_tilesScaleY;
+		quint64 m_tilesPaintCount;	//number of the calls of drawTiles(), used for removing the least recently drawn tiles
+		bool m_pixmapIsDirty;	//true if m_pixmap has to be drawn again, see drawPixmap()
 
 		void retransform();
+		bool retransformAsync();
+		void applyGeometry();
+		void waitForGeometry();
+		bool canAppendPoints() const;
+		bool retransformAppended();
+		bool canDecimatePoints() const;
+		bool decimatePoints(int& count);
+		void addDecimatedPoint(double x, double y, int& count);
 		void updateLines();
+		void addLineSegments(QVector<QLineF>&, int first) const;
 		void updateDropLines();
+		void addDropLines(QPainterPath&, int first) const;
 		void updateSymbols();
+		void addSymbols(QPainterPath&, int first) const;
 		void updateValues();
+		void addValues(QPainterPath&, int first, int firstScenePoint);
 		void updateFilling();
 		void updateErrorBars();
+		void addErrorBars(QPainterPath&, int first) const;
 		bool swapVisible(bool on);
 		void recalcShapeAndBoundingRect();
+		void addShape(const QPainterPath& linePart, const QPainterPath& dropLinePart, const QPainterPath& symbolsPart,
+					const QPainterPath& valuesPart, const QPainterPath& errorBarsPart);
+		const QPixmap& symbolSprite(qreal scale);
+		bool showsSymbolsDensity() const;
+		QRectF symbolsSceneRect() const;
+		void updateDensityImage(qreal scale);
 		void drawSymbols(QPainter*);
 		void drawValues(QPainter*);
 		void drawFilling(QPainter*);
 		void draw(QPainter*);
+		bool drawTiles(QPainter*, const QRectF& exposedRect, const QWidget*);
 		void updatePixmap();
+		void drawPixmap();
 
 		virtual void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* widget = 0);
 
@@ -91,6 +185,7 @@ class XYCurvePrivate: public QGraphicsItem {
 		QBrush symbolsBrush;
 		QPen symbolsPen;
 		qreal symbolsOpacity;
+		int symbolsDensityThreshold;	//number of visible points from which their density is drawn instead of the symbols, 0 for never
 		qreal symbolsRotationAngle;
 		qreal symbolsSize;
 
@@ -143,15 +238,21 @@ class XYCurvePrivate: public QGraphicsItem {
 		QPainterPath symbolsPath;
 		QRectF boundingRectangle;
 		QPainterPath curveShape;
-		QList<QLineF> lines;
-		QList<QPointF> symbolPointsLogical;	//points in logical coordinates
-		QList<QPointF> symbolPointsScene;	//points in scene coordinates
-		std::vector<bool> visiblePoints;	//vector of the size of symbolPointsLogical with true of false for the points currently visible or not in the plot
+		QVector<QLineF> lines;	//lines connecting the points in scene coordinates
+		QVector<double> symbolPointsLogicalX;	//x-values of the points in logical coordinates
+		QVector<double> symbolPointsLogicalY;	//y-values of the points in logical coordinates
+		QVector<double> symbolPointsSceneX;	//x-values of the visible points in scene coordinates
+		QVector<double> symbolPointsSceneY;	//y-values of the visible points in scene coordinates
+		std::vector<bool> visiblePoints;	//vector of the size of symbolPointsLogicalX with true of false for the points currently visible or not in the plot
 		QList<QPointF> valuesPoints;
-		std::vector<bool> connectedPointsLogical;  //vector of the size of symbolPointsLogical with true for points connected with the consecutive point and
+		std::vector<bool> connectedPointsLogical;  //vector of the size of symbolPointsLogicalX with true for points connected with the consecutive point and
 											       //false otherwise (don't connect because of a gap (NAN) in-between)
 		QList<QString> valuesStrings;
 		QList<QPolygonF> fillPolygons;
+		gsl_spline* lineSpline;	//spline of the spline line types, reused as long as the points and the line type don't change
+		XYCurve::LineType lineSplineType;
+		bool lineDecimated;	//true if linePath is decimated for the screen and the exact path has to be created from lines for printing
+		bool pointsDecimated;	//true if only the points needed to draw the line in the visible range on the screen were taken over
 
 		XYCurve* const q;
 
@@ -41,12 +41,18 @@
 #include "backend/gsl/ExpressionParser.h"
 #include "backend/gsl/parser_extern.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cfloat>
 extern "C" {
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_eigen.h>
+#include <gsl/gsl_rng.h>
 #include <gsl/gsl_version.h>
+#include "backend/nsl/nsl_fit.h"
 }
 
 #include <KIcon>
@@ -173,8 +179,8 @@ void XYFitCurve::handleSourceDataChanged() {
 //##############################################################################
 XYFitCurvePrivate::XYFitCurvePrivate(XYFitCurve* owner) : XYCurvePrivate(owner),
 	xDataColumn(0), yDataColumn(0), weightsColumn(0),
-	xColumn(0), yColumn(0), residualsColumn(0),
-	xVector(0), yVector(0), residualsVector(0),
+	xColumn(0), yColumn(0), residualsColumn(0), outliersColumn(0),
+	xVector(0), yVector(0), residualsVector(0), outliersVector(0),
 	sourceDataChangedSinceLastFit(false),
 	q(owner)  {
 
@@ -194,18 +200,60 @@ struct data {
 	int degree;
 	QString* func; // string containing the definition of the model/function
 	QStringList* paramNames;
+	//bounded and fixed parameters, paramFixed is 0 if all parameters are free and unbounded.
+	//Otherwise the solver works on the free parameters only, mapped to unbounded values.
+	size_t np; //number of model parameters
+	const double* paramMin; //lower limits of the parameters
+	const double* paramMax; //upper limits of the parameters
+	const bool* paramFixed; //fixed parameters
+	const double* paramStart; //start values, used for the fixed parameters
+	XYFitCurve::FitResult* fitResult; //diagnostics, counts and times of the evaluations are added here (0 - not counted)
 };
 
 /*!
- * \param v vector containing current values of the fit parameters
+ * returns the precompiled kernels for the predefined model in \c params
+ * or 0 if the model has to be evaluated with the parser (custom model or modified parameter list)
+ */
+const nsl_fit_model* fit_model(const struct data* params, size_t np) {
+	if (params->modelType == XYFitCurve::Custom)
+		return 0;
+
+	const nsl_fit_model* model = nsl_fit_model_get((nsl_fit_model_type)params->modelType);
+	if (!model || model->nparams(params->degree) != np)
+		return 0;
+
+	return model;
+}
+
+/*!
+ * \param v vector containing current values of the model parameters
  * \param params
  * \param f vector with the weighted residuals (Yi - y[i])/sigma[i]
  */
-int func_f(const gsl_vector* paramValues, void* params, gsl_vector* f) {
+int model_f(const gsl_vector* paramValues, void* params, gsl_vector* f) {
 	int n = ((struct data*)params)->n;
 	double* x = ((struct data*)params)->x;
 	double* y = ((struct data*)params)->y;
 	double* sigma = ((struct data*)params)->sigma;
+
+	//predefined models: evaluate the model for all data points at once
+	const nsl_fit_model* model = fit_model((struct data*)params, paramValues->size);
+	if (model) {
+		QVector<double> p(paramValues->size);
+		for (int j=0; j < p.size(); j++)
+			p[j] = gsl_vector_get(paramValues, j);
+
+		QVector<double> Y(n);
+		model->f(x, n, p.constData(), ((struct data*)params)->degree, Y.data());
+		for (int i=0; i < n; i++) {
+			if (sigma)
+				gsl_vector_set (f, i, (Y[i] - y[i])/sigma[i]);
+			else
+				gsl_vector_set (f, i, (Y[i] - y[i]));
+		}
+		return GSL_SUCCESS;
+	}
+
 	QByteArray funcba = ((struct data*)params)->func->toLocal8Bit();
 	const char *func = funcba.data();
 	QStringList* paramNames = ((struct data*)params)->paramNames;
@@ -248,17 +296,15 @@ int func_f(const gsl_vector* paramValues, void* params, gsl_vector* f) {
 
 /*!
  * calculates the matrix elements of Jacobian matrix
- * \param paramValues current parameter values
+ * \param paramValues current values of the model parameters
  * \param params
  * \param J Jacobian matrix
  * */
-int func_df(const gsl_vector* paramValues, void* params, gsl_matrix* J) {
+int model_df(const gsl_vector* paramValues, void* params, gsl_matrix* J) {
 	int n = ((struct data*)params)->n;
 	double* xVector = ((struct data*)params)->x;
 	double* sigmaVector = ((struct data*)params)->sigma;
 	QStringList* paramNames = ((struct data*)params)->paramNames;
-	XYFitCurve::ModelType modelType = ((struct data*)params)->modelType;
-	int degree = ((struct data*)params)->degree;
 
 	// calculate the Jacobian matrix:
 	// Jacobian matrix J(i,j) = dfi / dxj
@@ -268,208 +314,149 @@ int func_df(const gsl_vector* paramValues, void* params, gsl_matrix* J) {
 	double x;
 	double sigma = 1.0;
 
-	switch (modelType) {
-	case XYFitCurve::Polynomial:
-		// Y(x) = c0 + c1*x + ... + cn*x^n
-		for (int i=0; i < n; i++) {
-			x = xVector[i];
-			if (sigmaVector) sigma = sigmaVector[i];
-			for (int j=0; j<paramNames->size(); ++j) {
-				gsl_matrix_set(J, i, j, pow(x,j)/sigma);
-			}
-		}
-		break;
-	case XYFitCurve::Power:
-		// Y(x) = a*x^b or Y(x) = a + b*x^c.
-		if (degree == 1) {
-			double a = gsl_vector_get(paramValues,0);
-			double b = gsl_vector_get(paramValues,1);
-			for (int i=0; i<n; i++) {
-				x = xVector[i];
-				if (sigmaVector) sigma = sigmaVector[i];
-				gsl_matrix_set(J, i, 0, pow(x,b)/sigma);
-				gsl_matrix_set(J, i, 1, a*pow(x,b)*log(x)/sigma);
-			}
-		} else if (degree == 2) {
-			double b = gsl_vector_get(paramValues,1);
-			double c = gsl_vector_get(paramValues,2);
-			for (int i=0; i<n; i++) {
-				x = xVector[i];
-				if (sigmaVector) sigma = sigmaVector[i];
-				gsl_matrix_set(J, i, 0, 1/sigma);
-				gsl_matrix_set(J, i, 1, pow(x,c)/sigma);
-				gsl_matrix_set(J, i, 2, b*pow(x,c)*log(x)/sigma);
-			}
-		}
-		break;
-	case XYFitCurve::Exponential:
-		// Y(x) = a*exp(b*x) or Y(x) = a*exp(b*x) + c*exp(d*x) or Y(x) = a*exp(b*x) + c*exp(d*x) + e*exp(f*x)
-		if (degree == 1) {
-			double a = gsl_vector_get(paramValues,0);
-			double b = gsl_vector_get(paramValues,1);
-			for (int i=0; i<n; i++) {
-				x = xVector[i];
-				if (sigmaVector) sigma = sigmaVector[i];
-				gsl_matrix_set(J, i, 0, exp(b*x)/sigma);
-				gsl_matrix_set(J, i, 1, a*x*exp(b*x)/sigma);
-			}
-		} else if (degree == 2) {
-			double a = gsl_vector_get(paramValues,0);
-			double b = gsl_vector_get(paramValues,1);
-			double c = gsl_vector_get(paramValues,2);
-			double d = gsl_vector_get(paramValues,3);
-			for (int i=0; i<n; i++) {
-				x = xVector[i];
-				if (sigmaVector) sigma = sigmaVector[i];
-				gsl_matrix_set(J, i, 0, exp(b*x)/sigma);
-				gsl_matrix_set(J, i, 1, a*x*exp(b*x)/sigma);
-				gsl_matrix_set(J, i, 2, exp(d*x)/sigma);
-				gsl_matrix_set(J, i, 3, c*x*exp(d*x)/sigma);
-			}
-		} else if (degree == 3) {
-			double a = gsl_vector_get(paramValues,0);
-			double b = gsl_vector_get(paramValues,1);
-			double c = gsl_vector_get(paramValues,2);
-			double d = gsl_vector_get(paramValues,3);
-			double e = gsl_vector_get(paramValues,4);
-			double f = gsl_vector_get(paramValues,5);
+	//predefined models: analytic derivatives for all data points at once, written directly into J
+	const nsl_fit_model* model = fit_model((struct data*)params, paramValues->size);
+	if (model) {
+		const size_t np = paramValues->size;
+		QVector<double> p(np);
+		for (size_t j=0; j < np; j++)
+			p[j] = gsl_vector_get(paramValues, j);
+
+		model->df(xVector, n, p.constData(), ((struct data*)params)->degree, J->data, J->tda);
+		if (sigmaVector) {
 			for (int i=0; i < n; i++) {
-				x = xVector[i];
-				if (sigmaVector) sigma = sigmaVector[i];
-				gsl_matrix_set(J, i, 0, exp(b*x)/sigma);
-				gsl_matrix_set(J, i, 1, a*x*exp(b*x)/sigma);
-				gsl_matrix_set(J, i, 2, exp(d*x)/sigma);
-				gsl_matrix_set(J, i, 3, c*x*exp(b*x)/sigma);
-				gsl_matrix_set(J, i, 4, exp(f*x)/sigma);
-				gsl_matrix_set(J, i, 5, e*x*exp(f*x)/sigma);
+				gsl_vector_view row = gsl_matrix_row(J, i);
+				gsl_vector_scale(&row.vector, 1.0/sigmaVector[i]);
 			}
 		}
-		break;
-	case XYFitCurve::Inverse_Exponential: {
-		// Y(x) = a*(1-exp(b*x))+c
-		double a = gsl_vector_get(paramValues,0);
-		double b = gsl_vector_get(paramValues,1);
-		//double c = gsl_vector_get(paramValues,2);
-		for (int i=0; i < n; i++) {
-			x = xVector[i];
-			if (sigmaVector) sigma = sigmaVector[i];
-			gsl_matrix_set(J, i, 0, (1.0-exp(b*x))/sigma);
-			gsl_matrix_set(J, i, 1, -a*x*exp(b*x)/sigma);
-			gsl_matrix_set(J, i, 2, 1.0/sigma);
-		}
-		break;
+		return GSL_SUCCESS;
 	}
-	case XYFitCurve::Fourier: {
-		// Y(x) = a0 + (a1*cos(w*x) + b1*sin(w*x)) + ... + (an*cos(n*w*x) + bn*sin(n*w*x)
-		//parameters: w, a0, a1, b1, ... an, bn
-		double a[degree];
-		double b[degree];
-		double w = gsl_vector_get(paramValues,0);
-		a[0] = gsl_vector_get(paramValues,1);
-		b[0] = 0;
-		for (int j=1; j < degree; ++j) {
-			a[j] = gsl_vector_get(paramValues,2*j);
-			b[j] = gsl_vector_get(paramValues,2*j+1);
-		}
-		for (int i=0; i < n; i++) {
-			x = xVector[i];
-			if (sigmaVector) sigma = sigmaVector[i];
-			double wd = 0; //first derivative with respect to the w parameter
-			for (int j=1; j < degree; ++j) {
-				wd += -a[j]*j*x*sin(j*w*x) + b[j]*j*x*cos(j*w*x);
-			}
-			gsl_matrix_set(J, i, 0, wd/sigma);
-			gsl_matrix_set(J, i, 1, 1/sigma);
-			for (int j=1; j <= degree; ++j) {
-				gsl_matrix_set(J, i, 2*j, cos(j*w*x)/sigma);
-				gsl_matrix_set(J, i, 2*j+1, sin(j*w*x)/sigma);
+
+	//custom model: numerical derivatives
+	QByteArray funcba = ((struct data*)params)->func->toLocal8Bit();
+	char* func = funcba.data();
+	double eps = 1.0e-5;
+	QByteArray nameba;
+	char* name;
+	double value;
+	for (int i=0; i<n; i++) {
+		x = xVector[i];
+		if (sigmaVector) sigma = sigmaVector[i];
+		char var[]="x";
+		assign_variable(var, x);
+
+		for (int j=0; j < paramNames->size(); j++) {
+			for (int k=0; k < paramNames->size(); k++) {
+				if (k != j) {
+					nameba = paramNames->at(k).toLocal8Bit();
+					value = gsl_vector_get(paramValues,k);
+					assign_variable(nameba.data(), value);
+				}
 			}
+
+			nameba = paramNames->at(j).toLocal8Bit();
+			name = nameba.data();
+			value = gsl_vector_get(paramValues,j);
+			assign_variable(name, value);
+			double f_p = parse(func);
+
+			value = value + eps;
+			assign_variable(name, value);
+			double f_pdp = parse(func);
+
+			gsl_matrix_set(J, i, j, (f_pdp-f_p)/eps/sigma);
 		}
-		break;
 	}
-	case XYFitCurve::Gaussian: {
-		// Y(x) = a1*exp(-((x-b1)/c1)^2) + a2*exp(-((x-b2)/c2)^2) + ... + an*exp(-((x-bn)/cn)^2)
-		double a,b,c;
-		for (int i=0; i < n; i++) {
-			x = xVector[i];
-			if (sigmaVector) sigma = sigmaVector[i];
-			for (int j=0; j < degree; ++j) {
-				a = gsl_vector_get(paramValues,3*j);
-				b = gsl_vector_get(paramValues,3*j+1);
-				c = gsl_vector_get(paramValues,3*j+2);
-				gsl_matrix_set(J, i, 3*j, exp(-(x-b)*(x-b)/(c*c))/sigma);
-				gsl_matrix_set(J, i, 3*j+1, 2*a*(x-b)/(c*c)*exp(-(x-b)*(x-b)/(c*c))/sigma);
-				gsl_matrix_set(J, i, 3*j+2, 2*a*(x-b)*(x-b)/(c*c*c)*exp(-(x-b)*(x-b)/(c*c))/sigma);
-			}
-		}
-		break;
+
+	return GSL_SUCCESS;
+}
+
+/*!
+ * maps the values \c solverValues of the free parameters used by the solver to the values \c paramValues of all model parameters
+ */
+void model_params(const struct data* params, const gsl_vector* solverValues, gsl_vector* paramValues) {
+	if (!params->paramFixed) {
+		gsl_vector_memcpy(paramValues, solverValues);
+		return;
 	}
-	case XYFitCurve::Lorentz: {
-		// Y(x) = 1/pi*s/(s^2+(x-t)^2)
-		double s = gsl_vector_get(paramValues,0);
-		double t = gsl_vector_get(paramValues,1);
-		for (int i=0; i < n; i++) {
-			x = xVector[i];
-			if (sigmaVector) sigma = sigmaVector[i];
-			gsl_matrix_set(J, i, 0, (-s*s+(x-t)*(x-t))/pow(s*s+(x-t)*(x-t),2)/M_PI/sigma);
-			gsl_matrix_set(J, i, 1, 2*s*(x-t)/pow(s*s+(x-t)*(x-t),2)/M_PI/sigma);
-		}
-		break;
+
+	size_t k = 0;
+	for (size_t j=0; j < params->np; ++j) {
+		if (params->paramFixed[j])
+			gsl_vector_set(paramValues, j, params->paramStart[j]);
+		else
+			gsl_vector_set(paramValues, j, nsl_fit_map_bound(gsl_vector_get(solverValues, k++), params->paramMin[j], params->paramMax[j]));
 	}
-	case XYFitCurve::Maxwell: {
-		// Y(x) = sqrt(2/pi)*x^2*exp(-x^2/(2*a^2))/a^3
-		double a = gsl_vector_get(paramValues,0);
-		for (int i=0; i < n; i++) {
-			x = xVector[i];
-			if (sigmaVector) sigma = sigmaVector[i];
-			gsl_matrix_set(J, i, 0, sqrt(2/M_PI)*x*x*(x*x-3*a*a)*exp(-x*x/2/a/a)/pow(a,6)/sigma);
-		}
-		break;
+}
+
+/*!
+ * weighted residuals for the values \c paramValues of the free parameters used by the solver
+ */
+int func_f(const gsl_vector* paramValues, void* params, gsl_vector* f) {
+	const struct data* fitParams = (struct data*)params;
+	QElapsedTimer timer;
+	timer.start();
+
+	int status;
+	if (!fitParams->paramFixed) {
+		status = model_f(paramValues, params, f);
+	} else {
+		QVector<double> values(fitParams->np);
+		gsl_vector_view modelValues = gsl_vector_view_array(values.data(), fitParams->np);
+		model_params(fitParams, paramValues, &modelValues.vector);
+		status = model_f(&modelValues.vector, params, f);
 	}
-	case XYFitCurve::Sigmoid: {
-		//TODO
-		break;
+
+	if (fitParams->fitResult) {
+		fitParams->fitResult->fEvaluations++;
+		fitParams->fitResult->fTime += timer.nsecsElapsed()/1.e6;
 	}
-	case XYFitCurve::Custom: {
-		QByteArray funcba = ((struct data*)params)->func->toLocal8Bit();
-		char* func = funcba.data();
-		double eps = 1.0e-5;
-		QByteArray nameba;
-		char* name;
-		double value;
-		for (int i=0; i<n; i++) {
-			x = xVector[i];
-			if (sigmaVector) sigma = sigmaVector[i];
-			char var[]="x";
-			assign_variable(var, x);
-
-			for (int j=0; j < paramNames->size(); j++) {
-				for (int k=0; k < paramNames->size(); k++) {
-					if (k != j) {
-						nameba = paramNames->at(k).toLocal8Bit();
-						value = gsl_vector_get(paramValues,k);
-						assign_variable(nameba.data(), value);
-					}
-				}
 
-				nameba = paramNames->at(j).toLocal8Bit();
-				name = nameba.data();
-				value = gsl_vector_get(paramValues,j);
-				assign_variable(name, value);
-				double f_p = parse(func);
+	return status;
+}
 
-				value = value + eps;
-				assign_variable(name, value);
-				double f_pdp = parse(func);
+/*!
+ * Jacobian matrix with respect to the free parameters used by the solver:
+ * the columns of the free model parameters multiplied by the derivatives of the parameter transformation
+ */
+int func_df(const gsl_vector* paramValues, void* params, gsl_matrix* J) {
+	const struct data* fitParams = (struct data*)params;
+	QElapsedTimer timer;
+	timer.start();
 
-				gsl_matrix_set(J, i, j, (f_pdp-f_p)/eps/sigma);
-			}
+	if (!fitParams->paramFixed) {
+		const int status = model_df(paramValues, params, J);
+		if (fitParams->fitResult) {
+			fitParams->fitResult->dfEvaluations++;
+			fitParams->fitResult->dfTime += timer.nsecsElapsed()/1.e6;
 		}
-		break;
+		return status;
 	}
+
+	QVector<double> values(fitParams->np);
+	gsl_vector_view modelValues = gsl_vector_view_array(values.data(), fitParams->np);
+	model_params(fitParams, paramValues, &modelValues.vector);
+
+	gsl_matrix* modelJ = gsl_matrix_alloc(J->size1, fitParams->np);
+	const int status = model_df(&modelValues.vector, params, modelJ);
+
+	size_t k = 0;
+	for (size_t j=0; j < fitParams->np; ++j) {
+		if (fitParams->paramFixed[j])
+			continue;
+
+		gsl_vector_view column = gsl_matrix_column(J, k);
+		gsl_matrix_get_col(&column.vector, modelJ, j);
+		gsl_vector_scale(&column.vector, nsl_fit_map_bound_deriv(gsl_vector_get(paramValues, k), fitParams->paramMin[j], fitParams->paramMax[j]));
+		k++;
 	}
 
-	return GSL_SUCCESS;
+	gsl_matrix_free(modelJ);
+	if (fitParams->fitResult) {
+		fitParams->fitResult->dfEvaluations++;
+		fitParams->fitResult->dfTime += timer.nsecsElapsed()/1.e6;
+	}
+	return status;
 }
 
 int func_fdf(const gsl_vector* x, void* params, gsl_vector* f,gsl_matrix* J) {
@@ -478,6 +465,157 @@ int func_fdf(const gsl_vector* x, void* params, gsl_vector* f,gsl_matrix* J) {
 	return GSL_SUCCESS;
 }
 
+/*!
+ * evaluates the weighted residuals for the parameter values \c paramValues chunk by chunk
+ * and accumulates the sum of squared residuals \c chi2. If \c JTJ is given, the Jacobian is evaluated, too,
+ * and the normal equations J^T*J and J^T*f are accumulated in \c JTJ and \c JTf.
+ * \c f and \c J are the workspace for one chunk, their size determines the chunk size.
+ */
+int accumulate_normal_equations(const gsl_vector* paramValues, struct data* params, gsl_vector* f, gsl_matrix* J,
+								gsl_matrix* JTJ, gsl_vector* JTf, double* chi2) {
+	const size_t chunkSize = f->size;
+	struct data chunk = *params;
+	chunk.fitResult = 0; //one pass over all chunks is counted as one evaluation
+	qint64 fTime = 0;
+	qint64 dfTime = 0;
+	QElapsedTimer timer;
+
+	*chi2 = 0;
+	if (JTJ) {
+		gsl_matrix_set_zero(JTJ);
+		gsl_vector_set_zero(JTf);
+	}
+
+	for (size_t offset=0; offset < params->n; offset += chunkSize) {
+		const size_t m = GSL_MIN(chunkSize, params->n - offset);
+		chunk.n = m;
+		chunk.x = params->x + offset;
+		chunk.y = params->y + offset;
+		if (params->sigma)
+			chunk.sigma = params->sigma + offset;
+
+		gsl_vector_view fChunk = gsl_vector_subvector(f, 0, m);
+		timer.start();
+		const int status = func_f(paramValues, &chunk, &fChunk.vector);
+		fTime += timer.nsecsElapsed();
+		if (status)
+			return status;
+
+		const double norm = gsl_blas_dnrm2(&fChunk.vector);
+		*chi2 += norm*norm;
+
+		if (JTJ) {
+			gsl_matrix_view JChunk = gsl_matrix_submatrix(J, 0, 0, m, J->size2);
+			timer.start();
+			func_df(paramValues, &chunk, &JChunk.matrix);
+			dfTime += timer.nsecsElapsed();
+			gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, &JChunk.matrix, 1.0, JTJ);
+			gsl_blas_dgemv(CblasTrans, 1.0, &JChunk.matrix, &fChunk.vector, 1.0, JTf);
+		}
+	}
+
+	if (params->fitResult) {
+		params->fitResult->fEvaluations++;
+		params->fitResult->fTime += fTime/1.e6;
+		if (JTJ) {
+			params->fitResult->dfEvaluations++;
+			params->fitResult->dfTime += dfTime/1.e6;
+		}
+	}
+
+	//dsyrk only updates the lower triangle, complete the symmetric matrix
+	if (JTJ) {
+		for (size_t i=0; i < JTJ->size1; ++i)
+			for (size_t j=i+1; j < JTJ->size2; ++j)
+				gsl_matrix_set(JTJ, i, j, gsl_matrix_get(JTJ, j, i));
+	}
+
+	return GSL_SUCCESS;
+}
+
+/*!
+ * robust estimate of the scale of the residuals \c r - the median absolute deviation scaled
+ * to be consistent with the standard deviation for normally distributed residuals
+ */
+double robust_scale(const double* r, size_t n) {
+	QVector<double> absr(n);
+	for (size_t i=0; i < n; ++i)
+		absr[i] = fabs(r[i]);
+
+	std::nth_element(absr.begin(), absr.begin() + n/2, absr.end());
+	return absr[n/2]/0.6745;
+}
+
+/*!
+ * weight w(u) = psi(u)/u of the robust loss function \c type for the scaled residual \c u.
+ * The tuning constants give 95% asymptotic efficiency for normally distributed residuals.
+ */
+double robust_weight(XYFitCurve::RobustType type, double u) {
+	switch (type) {
+	case XYFitCurve::RobustHuber: {
+		const double c = 1.345;
+		return (fabs(u) <= c) ? 1.0 : c/fabs(u);
+	}
+	case XYFitCurve::RobustCauchy: {
+		const double c = 2.385;
+		return 1.0/(1.0 + (u/c)*(u/c));
+	}
+	case XYFitCurve::RobustBisquare: {
+		const double c = 4.685;
+		if (fabs(u) >= c)
+			return 0;
+		const double t = 1.0 - (u/c)*(u/c);
+		return t*t;
+	}
+	case XYFitCurve::RobustNone:
+		break;
+	}
+
+	return 1.0;
+}
+
+/*!
+ * condition number (ratio of the largest to the smallest eigenvalue) of the symmetric positive semi-definite matrix \c m,
+ * infinity for a singular matrix
+ */
+double condition_number(const gsl_matrix* m) {
+	const size_t np = m->size1;
+	gsl_matrix* A = gsl_matrix_alloc(np, np);
+	gsl_matrix_memcpy(A, m);
+	gsl_vector* eval = gsl_vector_alloc(np);
+	gsl_eigen_symm_workspace* w = gsl_eigen_symm_alloc(np);
+	gsl_eigen_symm(A, eval, w);
+
+	double min, max;
+	gsl_vector_minmax(eval, &min, &max);
+
+	gsl_eigen_symm_free(w);
+	gsl_vector_free(eval);
+	gsl_matrix_free(A);
+
+	return (min > 0) ? max/min : GSL_POSINF;
+}
+
+/*!
+ * reason for the termination of the solver with the GSL status \c status
+ */
+XYFitCurve::ConvergenceType convergence_type(int status) {
+	switch (status) {
+	case GSL_SUCCESS:
+		return XYFitCurve::ConvergenceStepSize;
+	case GSL_CONTINUE:
+		return XYFitCurve::ConvergenceMaxIterations;
+	case GSL_ENOPROG:
+	case GSL_ENOPROGJ:
+	case GSL_ETOLF:
+	case GSL_ETOLX:
+	case GSL_ETOLG:
+		return XYFitCurve::ConvergenceNoProgress;
+	default:
+		return XYFitCurve::ConvergenceError;
+	}
+}
+
 void XYFitCurvePrivate::recalculate() {
 	QElapsedTimer timer;
 	timer.start();
@@ -509,6 +647,14 @@ void XYFitCurvePrivate::recalculate() {
 		residualsVector->clear();
 	}
 
+	//the outliers column is missing in projects saved before it was introduced
+	if (!outliersColumn) {
+		outliersColumn = new Column("outliers", AbstractColumn::Numeric);
+		outliersVector = static_cast<QVector<double>* >(outliersColumn->data());
+		q->addChild(outliersColumn);
+	} else
+		outliersVector->clear();
+
 	// clear the previous result
 	fitResult = XYFitCurve::FitResult();
 
@@ -555,6 +701,7 @@ void XYFitCurvePrivate::recalculate() {
 	QVector<double> xdataVector;
 	QVector<double> ydataVector;
 	QVector<double> sigmaVector;
+	const bool robust = (fitData.robustType != XYFitCurve::RobustNone);
 	for (int row=0; row<xDataColumn->rowCount(); ++row) {
 		//only copy those data where _all_ values (for x, y and sigma, if given) are valid
 		if (!std::isnan(xDataColumn->valueAt(row)) && !std::isnan(yDataColumn->valueAt(row))
@@ -591,10 +738,50 @@ void XYFitCurvePrivate::recalculate() {
 		return;
 	}
 
-	if (n<np) {
+	//limits and fixed parameters
+	QVector<double> paramMin(np, -DBL_MAX);
+	QVector<double> paramMax(np, DBL_MAX);
+	QVector<bool> paramFixed(np, false);
+	if (fitData.paramLowerLimits.size() == (int)np && fitData.paramUpperLimits.size() == (int)np && fitData.paramFixed.size() == (int)np) {
+		paramMin = fitData.paramLowerLimits;
+		paramMax = fitData.paramUpperLimits;
+		paramFixed = fitData.paramFixed;
+	}
+
+	unsigned int npFree = 0; //number of free parameters
+	bool transformed = false; //true if at least one parameter is fixed or bounded
+	for (unsigned int j=0; j<np; ++j) {
+		if (paramFixed[j]) {
+			transformed = true;
+			continue;
+		}
+
+		if (paramMin[j] > paramMax[j]) {
+			fitResult.available = true;
+			fitResult.valid = false;
+			fitResult.status = i18n("The lower limit of the parameter '%1' is larger than its upper limit.", fitData.paramNames.at(j));
+			emit (q->dataChanged());
+			sourceDataChangedSinceLastFit = false;
+			return;
+		}
+		if (paramMin[j] > -DBL_MAX || paramMax[j] < DBL_MAX)
+			transformed = true;
+		npFree++;
+	}
+
+	if (npFree == 0) {
 		fitResult.available = true;
 		fitResult.valid = false;
-		fitResult.status = i18n("The number of data points (%1) must be greater than or equal to the number of parameters (%2).", n, np);
+		fitResult.status = i18n("All parameters are fixed.");
+		emit (q->dataChanged());
+		sourceDataChangedSinceLastFit = false;
+		return;
+	}
+
+	if (n<npFree) {
+		fitResult.available = true;
+		fitResult.valid = false;
+		fitResult.status = i18n("The number of data points (%1) must be greater than or equal to the number of parameters (%2).", n, npFree);
 		emit (q->dataChanged());
 		sourceDataChangedSinceLastFit = false;
 		return;
@@ -607,51 +794,138 @@ void XYFitCurvePrivate::recalculate() {
 		sigma = sigmaVector.data();
 
 	//function to fit
-	gsl_multifit_function_fdf f;
-	struct data params = {n, xdata, ydata, sigma, fitData.modelType, fitData.degree, &fitData.model, &fitData.paramNames};
-	f.f = &func_f;
-	f.df = &func_df;
-	f.fdf = &func_fdf;
-	f.n = n;
-	f.p = np;
-	f.params = &params;
+	struct data params = {n, xdata, ydata, sigma, fitData.modelType, fitData.degree, &fitData.model, &fitData.paramNames, np, 0, 0, 0, 0, &fitResult};
+
+	//start values
+	QVector<double> startValues = fitData.paramStartValues;
+	if (fitData.autoStartValues) {
+		//estimate the start values from the data for the predefined models, keep the user defined ones if this fails
+		const nsl_fit_model* model = fit_model(&params, np);
+		QVector<double> guessedValues(np);
+		if (model && model->guess(xdata, ydata, n, fitData.degree, guessedValues.data()) == 0) {
+			for (unsigned int j=0; j<np; ++j) {
+				if (!paramFixed.at(j))
+					startValues[j] = guessedValues.at(j);
+			}
+		}
+	}
+
+	//values of the free parameters used by the solver, mapped to unbounded values for bounded parameters
+	QVector<double> solverValues(npFree);
+	if (transformed) {
+		params.paramMin = paramMin.constData();
+		params.paramMax = paramMax.constData();
+		params.paramFixed = paramFixed.constData();
+		params.paramStart = startValues.constData();
+		unsigned int k = 0;
+		for (unsigned int j=0; j<np; ++j) {
+			if (!paramFixed.at(j))
+				solverValues[k++] = nsl_fit_map_unbound(startValues.at(j), paramMin.at(j), paramMax.at(j));
+		}
+	} else
+		solverValues = startValues;
+	gsl_vector_view x = gsl_vector_view_array(solverValues.data(), npFree);
 
-	//initialize the solver
-	const gsl_multifit_fdfsolver_type* T = gsl_multifit_fdfsolver_lmsder;
-	gsl_multifit_fdfsolver* s = gsl_multifit_fdfsolver_alloc (T, n, np);
-	double* x_init = fitData.paramStartValues.data();
-	gsl_vector_view x = gsl_vector_view_array (x_init, np);
-	gsl_multifit_fdfsolver_set (s, &f, &x.vector);
+	//refine the start values by a fit on a stratified subsample of the data if requested
+	fitResult.solverOutput.clear();
+	if (fitData.prefitPoints > 0 && (unsigned int)fitData.prefitPoints >= npFree && (unsigned int)fitData.prefitPoints < n)
+		prefit(&params, &x.vector);
 
-	//iterate
 	int status;
 	int iter = 0;
-	fitResult.solverOutput.clear();
-	writeSolverState(s);
-	do {
-		iter++;
-		status = gsl_multifit_fdfsolver_iterate (s);
-		writeSolverState(s);
-		if (status) break;
-		status = gsl_multifit_test_delta (s->dx, s->x, delta, delta);
-	} while (status == GSL_CONTINUE && iter < maxIters);
+	gsl_matrix* covar = gsl_matrix_alloc (npFree, npFree);
+	residualsVector->resize(n);
+	gsl_vector_view residuals = gsl_vector_view_array(residualsVector->data(), n);
+	fitResult.paramValues.resize(np);
+	gsl_vector_view paramValues = gsl_vector_view_array(fitResult.paramValues.data(), np);
+
+	//robust fit: the robust weights w_i are applied by using the errors sigma_i/sqrt(w_i) in the fit,
+	//so the costs of the function and Jacobian evaluations are the same as for the weighted fit
+	QVector<double> robustSigmaVector;
+	if (robust) {
+		if (sigma)
+			robustSigmaVector = sigmaVector;
+		else
+			robustSigmaVector.fill(1.0, n);
+		params.sigma = robustSigmaVector.data();
+	}
+
+	fitResult.prepareTime = timer.nsecsElapsed()/1.e6;
+	QElapsedTimer solverTimer;
+	solverTimer.start();
 
-	//get the covariance matrix
-	gsl_matrix* covar = gsl_matrix_alloc (np, np);
+	if (fitData.largeDataMode) {
+		status = fitLargeData(&params, sigma, &x.vector, covar, iter);
+	} else {
+		gsl_multifit_function_fdf f;
+		f.f = &func_f;
+		f.df = &func_df;
+		f.fdf = &func_fdf;
+		f.n = n;
+		f.p = npFree;
+		f.params = &params;
+
+		//initialize the solver
+		const gsl_multifit_fdfsolver_type* T = gsl_multifit_fdfsolver_lmsder;
+		gsl_multifit_fdfsolver* s = gsl_multifit_fdfsolver_alloc (T, n, npFree);
+		gsl_multifit_fdfsolver_set (s, &f, &x.vector);
+
+		//iterate
+		writeSolverState(&params, s);
+		do {
+			iter++;
+			status = gsl_multifit_fdfsolver_iterate (s);
+			writeSolverState(&params, s);
+			if (status) break;
+			status = gsl_multifit_test_delta (s->dx, s->x, delta, delta);
+
+			//robust fit: the fit with the current weights converged -> update the weights and continue until they are stable
+			if (status == GSL_SUCCESS && robust && updateRobustWeights(&params, sigma, s->x)) {
+				gsl_vector_memcpy(&x.vector, s->x);
+				gsl_multifit_fdfsolver_set (s, &f, &x.vector);
+				status = GSL_CONTINUE;
+			}
+		} while (status == GSL_CONTINUE && iter < maxIters);
+
+		//get the covariance matrix
 #if GSL_MAJOR_VERSION >=2
-	gsl_matrix *J=0;
-	gsl_multifit_fdfsolver_jac (s, J);
-	gsl_multifit_covar (J, 0.0, covar);
+		gsl_matrix* J = gsl_matrix_alloc (n, npFree);
+		gsl_multifit_fdfsolver_jac (s, J);
+		gsl_multifit_covar (J, 0.0, covar);
+		gsl_matrix_free (J);
 #else
-	gsl_multifit_covar (s->J, 0.0, covar);
+		gsl_multifit_covar (s->J, 0.0, covar);
 #endif
 
+		gsl_vector_memcpy(&x.vector, s->x);
+		gsl_multifit_fdfsolver_free(s);
+	}
+	model_params(&params, &x.vector, &paramValues.vector);
+
+	//the covariance matrix (J^T*J)^-1 has the same condition number as J^T*J
+	fitResult.conditionNumber = condition_number(covar);
+	fitResult.convergence = convergence_type(status);
+	fitResult.solverTime = solverTimer.nsecsElapsed()/1.e6;
+
+	//residuals for the final parameter values, without the robust weights
+	params.sigma = sigma;
+	model_f(&paramValues.vector, &params, &residuals.vector);
+
+	//flag the outliers of the robust fit in the outliers column, one value per fitted data point like the residuals.
+	//the source data is not changed.
+	if (robust && fitData.markOutliers) {
+		const double scale = robust_scale(residualsVector->constData(), n);
+		outliersVector->resize(n);
+		for (unsigned int i=0; i<n; ++i)
+			(*outliersVector)[i] = (scale > 0 && fabs(residualsVector->at(i)) > fitData.outlierThreshold*scale) ? 1 : 0;
+	}
+
 	//write the result
 	fitResult.available = true;
 	fitResult.valid = true;
 	fitResult.status = QString(gsl_strerror(status)); //TODO: add i18n
 	fitResult.iterations = iter;
-	fitResult.dof = n-np;
+	fitResult.dof = n-npFree;
 
 	//calculate:
 	//residuals (Y_i-y_i)
@@ -664,18 +938,15 @@ void XYFitCurvePrivate::recalculate() {
 	//Coefficient of determination, R-squared = 1 - SSE/SSTOT with the total sum of squares SSTOT = \sum_i (y_i - ybar)^2 and ybar = 1/n \sum_i y_i
 	//Adjusted Coefficient of determination  adj. R-squared = 1 - (1-R-squared^2)*(n-1)/(n-np-1);
 
-	residualsVector->resize(n);
-	for (unsigned int i=0; i<n; ++i) {
-		residualsVector->data()[i] = gsl_vector_get(s->f, i);
-	}
 	residualsColumn->setChanged();
+	outliersColumn->setChanged();
 
 	//gsl_blas_dnrm2() - computes the Euclidian norm (||x||_2 = \sqrt {\sum x_i^2}) of the vector with the elements (Yi - y[i])/sigma[i]
 	//gsl_blas_dasum() - computes the absolute sum \sum |x_i| of the elements of the vector with the elements (Yi - y[i])/sigma[i]
-	fitResult.sse = pow(gsl_blas_dnrm2(s->f), 2);
+	fitResult.sse = pow(gsl_blas_dnrm2(&residuals.vector), 2);
 	fitResult.mse = fitResult.sse/n;
 	fitResult.rmse = sqrt(fitResult.mse);
-	fitResult.mae = gsl_blas_dasum(s->f);
+	fitResult.mae = gsl_blas_dasum(&residuals.vector);
 	if (fitResult.dof!=0) {
 		fitResult.rms = fitResult.sse/fitResult.dof;
 		fitResult.rsd = sqrt(fitResult.rms);
@@ -690,19 +961,24 @@ void XYFitCurvePrivate::recalculate() {
 	for (unsigned int i=0; i<n; ++i)
 		sstot += pow(ydata[i]-ybar, 2);
 	fitResult.rsquared = 1 - fitResult.sse/sstot;
-	fitResult.rsquaredAdj = 1-(1-fitResult.rsquared*fitResult.rsquared)*(n-1)/(n-np-1);
+	fitResult.rsquaredAdj = 1-(1-fitResult.rsquared*fitResult.rsquared)*(n-1)/(n-npFree-1);
 
-	//parameter values
+	//parameter errors, the errors of the bounded parameters are propagated through the parameter transformation,
+	//the fixed parameters have no error
 	double c = GSL_MIN_DBL(1, sqrt(fitResult.sse)); //limit error for poor fit
-	fitResult.paramValues.resize(np);
-	fitResult.errorValues.resize(np);
+	fitResult.errorValues.fill(0, np);
+	unsigned int k = 0;
 	for (unsigned int i=0; i<np; i++) {
-		fitResult.paramValues[i] = gsl_vector_get(s->x, i);
-		fitResult.errorValues[i] = c*sqrt(gsl_matrix_get(covar,i,i));
+		if (paramFixed.at(i))
+			continue;
+
+		fitResult.errorValues[i] = c*sqrt(gsl_matrix_get(covar,k,k));
+		if (transformed)
+			fitResult.errorValues[i] *= fabs(nsl_fit_map_bound_deriv(solverValues.at(k), paramMin.at(i), paramMax.at(i)));
+		k++;
 	}
 
 	//free resources
-	gsl_multifit_fdfsolver_free(s);
 	gsl_matrix_free(covar);
 
 	//calculate the fit function (vectors)
@@ -724,18 +1000,238 @@ void XYFitCurvePrivate::recalculate() {
 	sourceDataChangedSinceLastFit = false;
 }
 
+/*!
+ * fits the model to a stratified subsample of \c fitData.prefitPoints data points and writes
+ * the resulting parameter values to \c paramValues to be used as start values for the fit of the full data.
+ * The data is divided into strata of equal size and one randomly chosen point of every stratum is used.
+ * \c paramValues is left unchanged if the fit of the subsample fails.
+ */
+int XYFitCurvePrivate::prefit(void* params, gsl_vector* paramValues) {
+	const struct data* fullData = (struct data*)params;
+	const size_t m = fitData.prefitPoints;
+	const size_t np = paramValues->size;
+
+	QVector<double> xSample(m);
+	QVector<double> ySample(m);
+	QVector<double> sigmaSample;
+	if (fullData->sigma)
+		sigmaSample.resize(m);
+
+	//the generator is used with its default seed so the subsample and the fit result are reproducible
+	gsl_rng* r = gsl_rng_alloc(gsl_rng_mt19937);
+	for (size_t i=0; i < m; ++i) {
+		const size_t start = i*fullData->n/m;
+		const size_t end = (i+1)*fullData->n/m;
+		const size_t row = start + gsl_rng_uniform_int(r, end - start);
+		xSample[i] = fullData->x[row];
+		ySample[i] = fullData->y[row];
+		if (fullData->sigma)
+			sigmaSample[i] = fullData->sigma[row];
+	}
+	gsl_rng_free(r);
+
+	struct data sampleData = *fullData;
+	sampleData.n = m;
+	sampleData.x = xSample.data();
+	sampleData.y = ySample.data();
+	sampleData.sigma = fullData->sigma ? sigmaSample.data() : 0;
+
+	gsl_multifit_function_fdf f;
+	f.f = &func_f;
+	f.df = &func_df;
+	f.fdf = &func_fdf;
+	f.n = m;
+	f.p = np;
+	f.params = &sampleData;
+
+	gsl_multifit_fdfsolver* s = gsl_multifit_fdfsolver_alloc(gsl_multifit_fdfsolver_lmsder, m, np);
+	gsl_multifit_fdfsolver_set(s, &f, paramValues);
+
+	int status;
+	int iter = 0;
+	do {
+		iter++;
+		status = gsl_multifit_fdfsolver_iterate(s);
+		if (status) break;
+		status = gsl_multifit_test_delta(s->dx, s->x, fitData.eps, fitData.eps);
+	} while (status == GSL_CONTINUE && iter < fitData.maxIterations);
+
+	bool finite = true;
+	for (size_t i=0; i < np; ++i)
+		finite = finite && gsl_finite(gsl_vector_get(s->x, i));
+	if (finite && (status == GSL_SUCCESS || status == GSL_CONTINUE))
+		gsl_vector_memcpy(paramValues, s->x);
+
+	gsl_multifit_fdfsolver_free(s);
+	return status;
+}
+
+/*!
+ * Levenberg-Marquardt fit for large data sets. Instead of the full n x np Jacobian used by the GSL solver,
+ * only the normal equations J^T*J and J^T*f are held in memory. They are accumulated over chunks of
+ * \c fitData.chunkSize data points so that the memory needed is O(np^2) independent of the number of data points.
+ * On return, \c paramValues contains the fitted parameters and \c covar the covariance matrix (J^T*J)^-1.
+ * Returns the GSL status of the fit.
+ */
+int XYFitCurvePrivate::fitLargeData(void* params, const double* sigma, gsl_vector* paramValues, gsl_matrix* covar, int& iter) {
+	struct data* fitParams = (struct data*)params;
+	const size_t np = paramValues->size;
+	const size_t chunkSize = GSL_MIN((size_t)qMax(fitData.chunkSize, 1), fitParams->n);
+	const double delta = fitData.eps;
+
+	//non-positive definite matrices are handled below, don't abort in the GSL error handler
+	gsl_set_error_handler_off();
+
+	gsl_vector* f = gsl_vector_alloc(chunkSize);
+	gsl_matrix* J = gsl_matrix_alloc(chunkSize, np);
+	gsl_matrix* JTJ = gsl_matrix_alloc(np, np);
+	gsl_vector* JTf = gsl_vector_alloc(np);
+	gsl_matrix* A = gsl_matrix_alloc(np, np);
+	gsl_vector* dx = gsl_vector_alloc(np);
+	gsl_vector* trial = gsl_vector_alloc(np);
+
+	double chi2 = 0;
+	double trialChi2 = 0;
+	double lambda = 1e-3; //damping parameter
+	iter = 0;
+	int status = accumulate_normal_equations(paramValues, fitParams, f, J, JTJ, JTf, &chi2);
+	writeSolverState(params, paramValues, chi2);
+
+	if (status == GSL_SUCCESS) {
+		do {
+			iter++;
+
+			//solve (J^T*J + lambda*diag(J^T*J))*dx = -J^T*f and increase the damping until the step reduces chi2
+			bool accepted = false;
+			bool converged = false;
+			while (!accepted && lambda < 1e10) {
+				gsl_matrix_memcpy(A, JTJ);
+				for (size_t i=0; i < np; ++i) {
+					const double d = gsl_matrix_get(JTJ, i, i);
+					gsl_matrix_set(A, i, i, d + lambda*(d > 0 ? d : 1.0));
+				}
+
+				if (gsl_linalg_cholesky_decomp(A) != GSL_SUCCESS) {
+					lambda *= 10;
+					continue;
+				}
+				gsl_linalg_cholesky_solve(A, JTf, dx);
+				gsl_vector_scale(dx, -1.0);
+
+				gsl_vector_memcpy(trial, paramValues);
+				gsl_vector_add(trial, dx);
+				if (accumulate_normal_equations(trial, fitParams, f, J, 0, 0, &trialChi2) == GSL_SUCCESS && trialChi2 <= chi2) {
+					accepted = true;
+				} else if (gsl_multifit_test_delta(dx, paramValues, delta, delta) == GSL_SUCCESS) {
+					//no further improvement possible with steps below the tolerance
+					converged = true;
+					break;
+				} else {
+					lambda *= 10;
+				}
+			}
+
+			if (!accepted && !converged) {
+				status = GSL_ENOPROG;
+				break;
+			}
+
+			if (accepted) {
+				lambda = GSL_MAX(lambda/10, 1e-12);
+				gsl_vector_memcpy(paramValues, trial);
+				status = accumulate_normal_equations(paramValues, fitParams, f, J, JTJ, JTf, &chi2);
+				writeSolverState(params, paramValues, chi2);
+				if (status) break;
+				status = gsl_multifit_test_delta(dx, paramValues, delta, delta);
+			} else {
+				status = GSL_SUCCESS;
+			}
+
+			//robust fit: the fit with the current weights converged -> update the weights and continue until they are stable
+			if (status == GSL_SUCCESS && fitData.robustType != XYFitCurve::RobustNone
+				&& updateRobustWeights(params, sigma, paramValues)) {
+				status = accumulate_normal_equations(paramValues, fitParams, f, J, JTJ, JTf, &chi2);
+				if (status) break;
+				status = GSL_CONTINUE;
+			}
+		} while (status == GSL_CONTINUE && iter < fitData.maxIterations);
+	}
+
+	//covariance matrix
+	gsl_matrix_memcpy(covar, JTJ);
+	if (gsl_linalg_cholesky_decomp(covar) == GSL_SUCCESS)
+		gsl_linalg_cholesky_invert(covar);
+	else
+		gsl_matrix_set_zero(covar);
+
+	gsl_vector_free(f);
+	gsl_matrix_free(J);
+	gsl_matrix_free(JTJ);
+	gsl_vector_free(JTf);
+	gsl_matrix_free(A);
+	gsl_vector_free(dx);
+	gsl_vector_free(trial);
+
+	return status;
+}
+
+/*!
+ * IRLS step of the robust fit: calculates the residuals r_i for the parameter values \c paramValues with the
+ * original errors \c sigma and sets the errors used in the fit to sigma_i/sqrt(w_i), w_i being the robust weights
+ * of the residuals scaled by their robust scale estimate. The residuals column is used as the workspace.
+ * Returns \c true if the weights were changed noticeably and the fit has to be continued with the new weights.
+ */
+bool XYFitCurvePrivate::updateRobustWeights(void* params, const double* sigma, const gsl_vector* paramValues) {
+	struct data* fitParams = (struct data*)params;
+	const size_t n = fitParams->n;
+
+	struct data plainParams = *fitParams;
+	plainParams.sigma = const_cast<double*>(sigma);
+	gsl_vector_view residuals = gsl_vector_view_array(residualsVector->data(), n);
+	if (func_f(paramValues, &plainParams, &residuals.vector) != GSL_SUCCESS)
+		return false;
+
+	const double scale = robust_scale(residualsVector->constData(), n);
+	if (scale == 0 || !gsl_finite(scale))
+		return false;
+
+	double maxChange = 0;
+	for (size_t i=0; i < n; ++i) {
+		const double s = sigma ? sigma[i] : 1.0;
+		const double oldWeight = (s/fitParams->sigma[i])*(s/fitParams->sigma[i]);
+		//zero weights are replaced by a tiny weight to keep the errors finite
+		const double weight = GSL_MAX(robust_weight(fitData.robustType, residualsVector->at(i)/scale), 1e-12);
+		maxChange = GSL_MAX(maxChange, fabs(weight - oldWeight));
+		fitParams->sigma[i] = s/sqrt(weight);
+	}
+
+	return (maxChange > 1e-3);
+}
+
 /*!
  * writes out the current state of the solver \c s
  */
-void XYFitCurvePrivate::writeSolverState(gsl_multifit_fdfsolver* s) {
+void XYFitCurvePrivate::writeSolverState(void* params, gsl_multifit_fdfsolver* s) {
+	writeSolverState(params, s->x, pow(gsl_blas_dnrm2 (s->f),2));
+}
+
+/*!
+ * writes out the current values of the model parameters for the solver values \c solverValues
+ * and the current value \c chi2 of the chi2-function
+ */
+void XYFitCurvePrivate::writeSolverState(void* params, const gsl_vector* solverValues, double chi2) {
 	QString state;
 
+	QVector<double> values(fitData.paramNames.size());
+	gsl_vector_view paramValues = gsl_vector_view_array(values.data(), values.size());
+	model_params((struct data*)params, solverValues, &paramValues.vector);
+
 	//current parameter values, semicolon separated
-	for (int i=0; i<fitData.paramNames.size(); ++i)
-		state += QString::number(gsl_vector_get(s->x, i)) + '\t';
+	for (int i=0; i<values.size(); ++i)
+		state += QString::number(values.at(i)) + '\t';
 
 	//current value of the chi2-function
-	state += QString::number(pow(gsl_blas_dnrm2 (s->f),2));
+	state += QString::number(chi2);
 	state += ';';
 
 	fitResult.solverOutput += state;
@@ -763,11 +1259,18 @@ void XYFitCurve::save(QXmlStreamWriter* writer) const{
 	WRITE_COLUMN(d->weightsColumn, weightsColumn);
 	writer->writeAttribute( "modelType", QString::number(d->fitData.modelType) );
 	writer->writeAttribute( "weightsType", QString::number(d->fitData.weightsType) );
+	writer->writeAttribute( "robustType", QString::number(d->fitData.robustType) );
+	writer->writeAttribute( "markOutliers", QString::number(d->fitData.markOutliers) );
+	writer->writeAttribute( "outlierThreshold", QString::number(d->fitData.outlierThreshold) );
 	writer->writeAttribute( "degree", QString::number(d->fitData.degree) );
 	writer->writeAttribute( "model", d->fitData.model );
+	writer->writeAttribute( "autoStartValues", QString::number(d->fitData.autoStartValues) );
 	writer->writeAttribute( "maxIterations", QString::number(d->fitData.maxIterations) );
 	writer->writeAttribute( "eps", QString::number(d->fitData.eps) );
 	writer->writeAttribute( "fittedPoints", QString::number(d->fitData.fittedPoints) );
+	writer->writeAttribute( "largeDataMode", QString::number(d->fitData.largeDataMode) );
+	writer->writeAttribute( "chunkSize", QString::number(d->fitData.chunkSize) );
+	writer->writeAttribute( "prefitPoints", QString::number(d->fitData.prefitPoints) );
 
 	writer->writeStartElement("paramNames");
 	for (int i=0; i<d->fitData.paramNames.size(); ++i)
@@ -779,6 +1282,22 @@ void XYFitCurve::save(QXmlStreamWriter* writer) const{
 		writer->writeTextElement("startValue", QString::number(d->fitData.paramStartValues.at(i)));
 	writer->writeEndElement();
 
+	//limits with full precision, -DBL_MAX and DBL_MAX (no limit) have to be restored exactly
+	writer->writeStartElement("paramLowerLimits");
+	for (int i=0; i<d->fitData.paramLowerLimits.size(); ++i)
+		writer->writeTextElement("lowerLimit", QString::number(d->fitData.paramLowerLimits.at(i), 'g', 17));
+	writer->writeEndElement();
+
+	writer->writeStartElement("paramUpperLimits");
+	for (int i=0; i<d->fitData.paramUpperLimits.size(); ++i)
+		writer->writeTextElement("upperLimit", QString::number(d->fitData.paramUpperLimits.at(i), 'g', 17));
+	writer->writeEndElement();
+
+	writer->writeStartElement("paramFixed");
+	for (int i=0; i<d->fitData.paramFixed.size(); ++i)
+		writer->writeTextElement("fixed", QString::number(d->fitData.paramFixed.at(i)));
+	writer->writeEndElement();
+
 	writer->writeEndElement();
 
 	//fit results (generated columns and goodness of the fit)
@@ -806,6 +1325,14 @@ void XYFitCurve::save(QXmlStreamWriter* writer) const{
 	writer->writeAttribute( "rsquared", QString::number(d->fitResult.rsquared) );
 	writer->writeAttribute( "rsquaredAdj", QString::number(d->fitResult.rsquaredAdj) );
 	writer->writeAttribute( "solverOutput", d->fitResult.solverOutput );
+	writer->writeAttribute( "convergence", QString::number(d->fitResult.convergence) );
+	writer->writeAttribute( "fEvaluations", QString::number(d->fitResult.fEvaluations) );
+	writer->writeAttribute( "dfEvaluations", QString::number(d->fitResult.dfEvaluations) );
+	writer->writeAttribute( "prepareTime", QString::number(d->fitResult.prepareTime) );
+	writer->writeAttribute( "solverTime", QString::number(d->fitResult.solverTime) );
+	writer->writeAttribute( "fTime", QString::number(d->fitResult.fTime) );
+	writer->writeAttribute( "dfTime", QString::number(d->fitResult.dfTime) );
+	writer->writeAttribute( "conditionNumber", QString::number(d->fitResult.conditionNumber) );
 
 	writer->writeStartElement("paramValues");
 	for (int i=0; i<d->fitResult.paramValues.size(); ++i)
@@ -822,6 +1349,8 @@ void XYFitCurve::save(QXmlStreamWriter* writer) const{
 		d->xColumn->save(writer);
 		d->yColumn->save(writer);
 		d->residualsColumn->save(writer);
+		if (d->outliersColumn)
+			d->outliersColumn->save(writer);
 	}
 
 	writer->writeEndElement(); //"fitResult"
@@ -871,6 +1400,18 @@ bool XYFitCurve::load(XmlStreamReader* reader) {
 			else
 				d->fitData.weightsType = (XYFitCurve::WeightsType)str.toInt();
 
+			str = attribs.value("robustType").toString();
+			if (!str.isEmpty())
+				d->fitData.robustType = (XYFitCurve::RobustType)str.toInt();
+
+			str = attribs.value("markOutliers").toString();
+			if (!str.isEmpty())
+				d->fitData.markOutliers = str.toInt();
+
+			str = attribs.value("outlierThreshold").toString();
+			if (!str.isEmpty())
+				d->fitData.outlierThreshold = str.toDouble();
+
 			str = attribs.value("degree").toString();
 			if (str.isEmpty())
 				reader->raiseWarning(attributeWarning.arg("'degree'"));
@@ -900,10 +1441,32 @@ bool XYFitCurve::load(XmlStreamReader* reader) {
 				reader->raiseWarning(attributeWarning.arg("'fittedPoints'"));
 			else
 				d->fitData.fittedPoints = str.toInt();
+
+			str = attribs.value("largeDataMode").toString();
+			if (!str.isEmpty())
+				d->fitData.largeDataMode = str.toInt();
+
+			str = attribs.value("chunkSize").toString();
+			if (!str.isEmpty())
+				d->fitData.chunkSize = str.toInt();
+
+			str = attribs.value("prefitPoints").toString();
+			if (!str.isEmpty())
+				d->fitData.prefitPoints = str.toInt();
+
+			str = attribs.value("autoStartValues").toString();
+			if (!str.isEmpty())
+				d->fitData.autoStartValues = str.toInt();
 		} else if (reader->name() == "name") {
 			d->fitData.paramNames<<reader->readElementText();
 		} else if (reader->name() == "startValue") {
 			d->fitData.paramStartValues<<reader->readElementText().toDouble();
+		} else if (reader->name() == "lowerLimit") {
+			d->fitData.paramLowerLimits<<reader->readElementText().toDouble();
+		} else if (reader->name() == "upperLimit") {
+			d->fitData.paramUpperLimits<<reader->readElementText().toDouble();
+		} else if (reader->name() == "fixed") {
+			d->fitData.paramFixed<<(bool)reader->readElementText().toInt();
 		} else if (reader->name() == "value") {
 			d->fitResult.paramValues<<reader->readElementText().toDouble();
 		} else if (reader->name() == "error") {
@@ -1000,6 +1563,38 @@ bool XYFitCurve::load(XmlStreamReader* reader) {
 				reader->raiseWarning(attributeWarning.arg("'solverOutput'"));
 			else
 				d->fitResult.solverOutput = str;
+
+			str = attribs.value("convergence").toString();
+			if (!str.isEmpty())
+				d->fitResult.convergence = (XYFitCurve::ConvergenceType)str.toInt();
+
+			str = attribs.value("fEvaluations").toString();
+			if (!str.isEmpty())
+				d->fitResult.fEvaluations = str.toInt();
+
+			str = attribs.value("dfEvaluations").toString();
+			if (!str.isEmpty())
+				d->fitResult.dfEvaluations = str.toInt();
+
+			str = attribs.value("prepareTime").toString();
+			if (!str.isEmpty())
+				d->fitResult.prepareTime = str.toDouble();
+
+			str = attribs.value("solverTime").toString();
+			if (!str.isEmpty())
+				d->fitResult.solverTime = str.toDouble();
+
+			str = attribs.value("fTime").toString();
+			if (!str.isEmpty())
+				d->fitResult.fTime = str.toDouble();
+
+			str = attribs.value("dfTime").toString();
+			if (!str.isEmpty())
+				d->fitResult.dfTime = str.toDouble();
+
+			str = attribs.value("conditionNumber").toString();
+			if (!str.isEmpty())
+				d->fitResult.conditionNumber = str.toDouble();
 		} else if (reader->name() == "column") {
 			Column* column = new Column("", AbstractColumn::Numeric);
 			if (!column->load(reader)) {
@@ -1012,6 +1607,8 @@ bool XYFitCurve::load(XmlStreamReader* reader) {
 				d->yColumn = column;
 			else if (column->name()=="residuals")
 				d->residualsColumn = column;
+			else if (column->name()=="outliers")
+				d->outliersColumn = column;
 		}
 	}
 
@@ -1023,6 +1620,10 @@ bool XYFitCurve::load(XmlStreamReader* reader) {
 		addChild(d->yColumn);
 
 		addChild(d->residualsColumn);
+		if (d->outliersColumn) {
+			addChild(d->outliersColumn);
+			d->outliersVector = static_cast<QVector<double>* >(d->outliersColumn->data());
+		}
 
 		d->xVector = static_cast<QVector<double>* >(d->xColumn->data());
 		d->yVector = static_cast<QVector<double>* >(d->yColumn->data());
@@ -38,29 +38,50 @@ class XYFitCurve: public XYCurve {
 	public:
 		enum ModelType {Polynomial, Power, Exponential, Inverse_Exponential, Fourier, Gaussian, Lorentz, Maxwell, Sigmoid, Custom};
 		enum WeightsType {WeightsFromColumn, WeightsFromErrorColumn};
+		enum RobustType {RobustNone, RobustHuber, RobustCauchy, RobustBisquare};
+		enum ConvergenceType {ConvergenceNone, ConvergenceStepSize, ConvergenceMaxIterations, ConvergenceNoProgress, ConvergenceError};
 
 		struct FitData {
 			FitData() : modelType(Polynomial),
 						weightsType(XYFitCurve::WeightsFromColumn),
+						robustType(XYFitCurve::RobustNone),
+						markOutliers(false),
+						outlierThreshold(3.0),
 						degree(1),
+						autoStartValues(false),
 						maxIterations(500),
 						eps(1e-4),
-						fittedPoints(100) {};
+						fittedPoints(100),
+						largeDataMode(false),
+						chunkSize(10000),
+						prefitPoints(0) {};
 
 			ModelType modelType;
 			WeightsType weightsType;
+			RobustType robustType; //loss function of the robust fit (iteratively reweighted least squares)
+			bool markOutliers; //flag the outliers of the robust fit in the outliers result column
+			double outlierThreshold; //residuals larger than this multiple of the robust residual scale are outliers
 			int degree;
 			QString model;
 			QStringList paramNames;
 			QVector<double> paramStartValues;
+			QVector<double> paramLowerLimits; //lower limits of the parameters, -DBL_MAX for no limit
+			QVector<double> paramUpperLimits; //upper limits of the parameters, DBL_MAX for no limit
+			QVector<bool> paramFixed; //fixed parameters keep their start value
+			bool autoStartValues; //estimate the start values from the data (predefined models only)
 
 			int maxIterations;
 			double eps;
 			int fittedPoints;
+
+			bool largeDataMode; //fit via normal equations accumulated in chunks, memory is O(np^2) independent of the number of points
+			int chunkSize; //number of data points processed at once in the large data mode
+			int prefitPoints; //size of the stratified subsample used to pre-fit the start values, 0 - no pre-fit
 		};
 
 		struct FitResult {
-			FitResult() : available(false), valid(false), iterations(0), elapsedTime(0), dof(0), sse(0), mse(0), rmse(0), mae(0), rms(0), rsd(0), rsquared(0), rsquaredAdj(0) {};
+			FitResult() : available(false), valid(false), iterations(0), elapsedTime(0), dof(0), sse(0), mse(0), rmse(0), mae(0), rms(0), rsd(0), rsquared(0), rsquaredAdj(0),
+						convergence(ConvergenceNone), fEvaluations(0), dfEvaluations(0), prepareTime(0), solverTime(0), fTime(0), dfTime(0), conditionNumber(0) {};
 
 			bool available;
 			bool valid;
@@ -79,6 +100,16 @@ class XYFitCurve: public XYCurve {
 			QVector<double> paramValues;
 			QVector<double> errorValues;
 			QString solverOutput;
+
+			//diagnostics, the evaluations include those of the pre-fit and of the robust weights, times are in ms
+			ConvergenceType convergence; //reason for the termination of the solver
+			int fEvaluations; //number of evaluations of the model function
+			int dfEvaluations; //number of evaluations of the Jacobian
+			double prepareTime; //time for the preparation of the data and of the start values (incl. pre-fit)
+			double solverTime; //time spent in the solver (incl. the function and Jacobian evaluations)
+			double fTime; //time spent in the evaluations of the model function
+			double dfTime; //time spent in the evaluations of the Jacobian
+			double conditionNumber; //condition number of J^T*J at the solution, with respect to the free (transformed) parameters
 		};
 
 		explicit XYFitCurve(const QString& name);
@@ -60,16 +60,22 @@ class XYFitCurvePrivate: public XYCurvePrivate {
 		Column* xColumn; //<! column used internally for storing the x-values of the result fit curve
 		Column* yColumn; //<! column used internally for storing the y-values of the result fit curve
 		Column* residualsColumn;
+		Column* outliersColumn; //<! 1 for the fitted data points which are outliers of the robust fit, 0 otherwise
 		QVector<double>* xVector;
 		QVector<double>* yVector;
 		QVector<double>* residualsVector;
+		QVector<double>* outliersVector;
 
 		bool sourceDataChangedSinceLastFit; //<! \c true if the data in the source columns (x, y, or weights) was changed, \c false otherwise
 
 		XYFitCurve* const q;
 
 	private:
-		void writeSolverState(gsl_multifit_fdfsolver* s);
+		int prefit(void* params, gsl_vector* paramValues);
+		int fitLargeData(void* params, const double* sigma, gsl_vector* paramValues, gsl_matrix* covar, int& iter);
+		bool updateRobustWeights(void* params, const double* sigma, const gsl_vector* paramValues);
+		void writeSolverState(void* params, gsl_multifit_fdfsolver* s);
+		void writeSolverState(void* params, const gsl_vector* solverValues, double chi2);
 };
 
 #endif
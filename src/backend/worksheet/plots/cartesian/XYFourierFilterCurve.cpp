@@ -42,9 +42,9 @@
 #include <cmath>	// isnan
 extern "C" {
 #include <gsl_errno.h>
-#include <gsl/gsl_fft_real.h>
-#include <gsl/gsl_fft_halfcomplex.h>
 #include <gsl/gsl_sf_pow_int.h>
+#include "backend/nsl/nsl_fft.h"
+#include "backend/nsl/nsl_filter.h"
 #include "backend/nsl/nsl_sf_poly.h"
 }
 
@@ -159,6 +159,7 @@ XYFourierFilterCurvePrivate::XYFourierFilterCurvePrivate(XYFourierFilterCurve* o
 	xColumn(0), yColumn(0), 
 	xVector(0), yVector(0), 
 	sourceDataChangedSinceLastFilter(false),
+	fftPlan(0),
 	q(owner) {
 
 }
@@ -166,11 +167,33 @@ XYFourierFilterCurvePrivate::XYFourierFilterCurvePrivate(XYFourierFilterCurve* o
 XYFourierFilterCurvePrivate::~XYFourierFilterCurvePrivate() {
 	//no need to delete xColumn and yColumn, they are deleted
 	//when the parent aspect is removed
+	nsl_fft_plan_free(fftPlan);
 }
 
 // ...
 // see XYFitCurvePrivate
 
+//maximal length of the FIR filters approximating the ideal filters in the streaming mode
+static const int maxFirTaps = 16385;
+//number of data points filtered at once in the streaming mode
+static const int streamChunkSize = 4096;
+
+/*!
+ * index of the halfcomplex transform of n points spanning the x-range range corresponding to the given cutoff
+ */
+static double cutoffIndex(double cutoff, XYFourierFilterCurve::CutoffUnit unit, unsigned int n, double range) {
+	switch (unit) {
+	case XYFourierFilterCurve::Frequency:
+		return 2*cutoff*range;
+	case XYFourierFilterCurve::Fraction:
+		return cutoff*n;
+	case XYFourierFilterCurve::Index:
+		return cutoff;
+	}
+
+	return 0;
+}
+
 void XYFourierFilterCurvePrivate::recalculate() {
 #ifndef NDEBUG
 	qDebug()<<"XYFourierFilterCurvePrivate::recalculate()";
@@ -218,13 +241,21 @@ void XYFourierFilterCurvePrivate::recalculate() {
 		return;
 	}
 
+	if (filterData.streaming) {
+		filterResult.available = true;
+		filterResult.valid = filterStreaming();
+		filterResult.elapsedTime = timer.elapsed();
+		emit (q->dataChanged());
+		sourceDataChangedSinceLastFilter = false;
+		return;
+	}
+
 	//copy all valid data point for the filter to temporary vectors
 	QVector<double> xdataVector;
 	QVector<double> ydataVector;
 	for (int row=0; row<xDataColumn->rowCount(); ++row) {
 		//only copy those data where _all_ values (for x and y, if given) are valid
-		if (!std::isnan(xDataColumn->valueAt(row)) && !std::isnan(yDataColumn->valueAt(row))
-				&& !xDataColumn->isMasked(row) && !yDataColumn->isMasked(row)) {
+		if (isValid(row)) {
 			xdataVector.append(xDataColumn->valueAt(row));
 			ydataVector.append(yDataColumn->valueAt(row));
 		}
@@ -241,6 +272,10 @@ void XYFourierFilterCurvePrivate::recalculate() {
 		return;
 	}
 
+	//length of the transform, the data is optionally padded with zeros to a length with small prime factors only
+	const unsigned int N = filterData.zeroPadding ? nsl_fft_fast_size(n) : n;
+	ydataVector.resize(N);
+
 	//double* xdata = xdataVector.data();
 	double* ydata = ydataVector.data();
 
@@ -248,49 +283,39 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	const double max = xDataColumn->maximum();
 
 	// filter settings
-	const XYFourierFilterCurve::FilterType type = filterData.type;
-	const XYFourierFilterCurve::FilterForm form = filterData.form;
-	const signed int order = filterData.order;
 	const double cutoff = filterData.cutoff, cutoff2 = filterData.cutoff2;
 	const XYFourierFilterCurve::CutoffUnit unit = filterData.unit, unit2 = filterData.unit2;
 #ifndef NDEBUG
-	qDebug()<<"n ="<<n;
-	qDebug()<<"type:"<<type;
-	qDebug()<<"form (order "<<order<<") :"<<form;
+	qDebug()<<"n ="<<n<<", FFT length ="<<N;
+	qDebug()<<"type:"<<filterData.type;
+	qDebug()<<"form (order "<<filterData.order<<") :"<<filterData.form;
 	qDebug()<<"cutoffs ="<<cutoff<<cutoff2;
 	qDebug()<<"unit :"<<unit<<unit2;
 #endif
 ///////////////////////////////////////////////////////////
 	int status;
-	// 1. transform
-	gsl_fft_real_workspace *work = gsl_fft_real_workspace_alloc(n);
-	gsl_fft_real_wavetable *real = gsl_fft_real_wavetable_alloc(n);
+	// 1. transform (the plan is reused for the same length)
+	if (!fftPlan || nsl_fft_plan_size(fftPlan) != N) {
+		nsl_fft_plan_free(fftPlan);
+		fftPlan = nsl_fft_plan_alloc(N);
+	}
+	if (!fftPlan) {
+		filterResult.available = true;
+		filterResult.valid = false;
+		filterResult.status = i18n("Failed to allocate the FFT.");
+		emit (q->dataChanged());
+		sourceDataChangedSinceLastFilter = false;
+		return;
+	}
 
-	status = gsl_fft_real_transform(ydata, 1, n, real, work);
-	gsl_fft_real_wavetable_free(real);
+	status = nsl_fft_real_transform(fftPlan, ydata);
 
 	// calculate index
-	double cutindex=0, cutindex2=0;
-	switch (unit) {
-	case XYFourierFilterCurve::Frequency:
-		cutindex = 2*cutoff*(max-min);
-		break;
-	case XYFourierFilterCurve::Fraction:
-		cutindex = cutoff*n;
-		break;
-	case XYFourierFilterCurve::Index:
-		cutindex = cutoff;
-	}
-	switch (unit2) {
-	case XYFourierFilterCurve::Frequency:
-		cutindex2 = 2*cutoff2*(max-min);
-		break;
-	case XYFourierFilterCurve::Fraction:
-		cutindex2 = cutoff2*n;
-		break;
-	case XYFourierFilterCurve::Index:
-		cutindex2 = cutoff2;
-	}
+	double cutindex = cutoffIndex(cutoff, unit, n, max-min);
+	double cutindex2 = cutoffIndex(cutoff2, unit2, n, max-min);
+	//the cutoffs refer to the unpadded data
+	cutindex *= (double)N/n;
+	cutindex2 *= (double)N/n;
 	const double centerindex = (cutindex2+cutindex)/2.;
 	const int bandwidth = (cutindex2-cutindex);
 	if(bandwidth <= 0) {
@@ -304,114 +329,241 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	qDebug()<<"bandwidth ="<<bandwidth;
 #endif
 
-	// 2. apply filter
+	// 2. apply filter (the response is only recalculated if the filter or the length changed)
+	updateGain(N, cutindex, cutindex2);
+	const double* g = gain.constData();
+	for (unsigned int i = 0; i < N; i++)
+		ydata[i] *= g[i];
+
+	// 3. back transform
+	status = nsl_fft_halfcomplex_inverse(fftPlan, ydata);
+
+	xVector->resize(n);
+	yVector->resize(n);
+	memcpy(xVector->data(), xdataVector.data(), n*sizeof(double));
+	memcpy(yVector->data(), ydata, n*sizeof(double));
+///////////////////////////////////////////////////////////
+
+	//write the result
+	filterResult.available = true;
+	filterResult.valid = true;
+	filterResult.status = QString(gsl_strerror(status));;
+	filterResult.elapsedTime = timer.elapsed();
+
+	//redraw the curve
+	emit (q->dataChanged());
+	sourceDataChangedSinceLastFilter = false;
+}
+
+/*!
+ * filters the data chunk by chunk with a causal filter without copying and transforming all data at once.
+ * The ideal filters are approximated by windowed-sinc FIR filters (overlap-save convolution, the delay of half the
+ * filter length is compensated), the other forms are realized as cascades of second order sections.
+ * Returns \c false if the filter can't be realized for the given cutoffs.
+ */
+bool XYFourierFilterCurvePrivate::filterStreaming() {
+	const int rows = xDataColumn->rowCount();
+	unsigned int n = 0;
+	for (int row=0; row<rows; ++row)
+		if (isValid(row))
+			++n;
+	if (n == 0) {
+		filterResult.status = i18n("No data points available.");
+		return false;
+	}
+
+	//cutoffs in units of the sample rate (the index n corresponds to the Nyquist frequency)
+	const double range = xDataColumn->maximum() - xDataColumn->minimum();
+	const double f1 = cutoffIndex(filterData.cutoff, filterData.unit, n, range)/(2.*n);
+	const double f2 = cutoffIndex(filterData.cutoff2, filterData.unit2, n, range)/(2.*n);
+	const nsl_filter_type type = (nsl_filter_type)filterData.type;
+	const bool band = (filterData.type == XYFourierFilterCurve::BandPass || filterData.type == XYFourierFilterCurve::BandReject);
+
+	nsl_filter_sos* sos = 0;
+	nsl_filter_fir* fir = 0;
+	size_t skip = 0;
+	if (filterData.form == XYFourierFilterCurve::Ideal) {
+		//transition width of about half of the narrowest band
+		double fmin = qMin(f1, 0.5-f1);
+		if (band)
+			fmin = qMin(fmin, qMin(f2-f1, 0.5-f2));
+		if (fmin > 0) {
+			const int taps = 2*(int)qMin(ceil(4./fmin), (double)(maxFirTaps/2)) + 1;
+			QVector<double> h(taps);
+			if (nsl_filter_fir_ideal(type, f1, f2, h.data(), taps) == 0)
+				fir = nsl_filter_fir_alloc(h.constData(), taps);
+			skip = (taps-1)/2;
+		}
+	} else
+		sos = nsl_filter_sos_design(type, (nsl_filter_form)filterData.form, filterData.order, f1, f2);
+
+	if (!sos && !fir) {
+		filterResult.status = i18n("The cutoffs must be between 0 and half of the sample rate.");
+		return false;
+	}
+
+	xVector->reserve(n);
+	yVector->reserve(n);
+	QVector<double> chunk;
+	chunk.reserve(streamChunkSize);
+	for (int row=0; row<rows; ++row) {
+		if (!isValid(row))
+			continue;
+
+		xVector->append(xDataColumn->valueAt(row));
+		chunk.append(yDataColumn->valueAt(row));
+		if (chunk.size() == streamChunkSize)
+			filterChunk(sos, fir, chunk, skip);
+	}
+	if (fir) {
+		//push the last values through the delay of the FIR filter
+		for (size_t i=0; i<skip; ++i)
+			chunk.append(0.);
+	}
+	filterChunk(sos, fir, chunk, skip);
+	if (fir) {
+		QVector<double> result(nsl_filter_fir_pending(fir));
+		const size_t count = nsl_filter_fir_flush(fir, result.data());
+		for (size_t i=skip; i<count; ++i)
+			yVector->append(result.at(i));
+	}
+
+	nsl_filter_sos_free(sos);
+	nsl_filter_fir_free(fir);
+	filterResult.status = QString(gsl_strerror(GSL_SUCCESS));
+
+	return true;
+}
+
+/*!
+ * filters the values in chunk, appends the results to the y-data (omitting the first skip results) and clears chunk
+ */
+void XYFourierFilterCurvePrivate::filterChunk(nsl_filter_sos* sos, nsl_filter_fir* fir, QVector<double>& chunk, size_t& skip) {
+	if (sos) {
+		nsl_filter_sos_process(sos, chunk.data(), chunk.size());
+		*yVector << chunk;
+	} else {
+		QVector<double> result(chunk.size() + nsl_filter_fir_pending(fir));
+		const size_t count = nsl_filter_fir_process(fir, chunk.constData(), chunk.size(), result.data());
+		size_t i = qMin(skip, count);
+		skip -= i;
+		for (; i<count; ++i)
+			yVector->append(result.at(i));
+	}
+	chunk.resize(0);
+}
+
+/*!
+ * returns \c true if the x- and y-values in the given row are valid (not masked and not NaN)
+ */
+bool XYFourierFilterCurvePrivate::isValid(int row) const {
+	return !std::isnan(xDataColumn->valueAt(row)) && !std::isnan(yDataColumn->valueAt(row))
+		&& !xDataColumn->isMasked(row) && !yDataColumn->isMasked(row);
+}
+
+/*!
+ * calculates the response of the filter for the N halfcomplex values of the transform,
+ * if it was not calculated for the same parameters before
+ */
+void XYFourierFilterCurvePrivate::updateGain(unsigned int N, double cutindex, double cutindex2) {
+	const XYFourierFilterCurve::FilterType type = filterData.type;
+	const XYFourierFilterCurve::FilterForm form = filterData.form;
+	const signed int order = filterData.order;
+
+	QVector<double> parameters;
+	parameters << type << form << order << cutindex << cutindex2;
+	if (gain.size() == (int)N && parameters == gainParameters)
+		return;
+	gainParameters = parameters;
+
+	gain.fill(1., N);
+	const double centerindex = (cutindex2+cutindex)/2.;
+	const int bandwidth = (cutindex2-cutindex);
 	unsigned int i;
 	switch (type) {
 	case XYFourierFilterCurve::LowPass:
 		switch (form) {
 		case XYFourierFilterCurve::Ideal:
-			for (i = cutindex; i < n; i++)
-				ydata[i] = 0;
+			for (i = cutindex; i < N; i++)
+				gain[i] = 0;
 			break;
 		case XYFourierFilterCurve::Butterworth:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+gsl_sf_pow_int(i/cutindex,2*order));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+gsl_sf_pow_int(i/cutindex,2*order));
 			break;
 		case XYFourierFilterCurve::ChebyshevI:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,i/cutindex),2));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,i/cutindex),2));
 			break;
 		case XYFourierFilterCurve::ChebyshevII:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+1./gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,cutindex/i),2));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+1./gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,cutindex/i),2));
 			break;
 		}
 		break;
 	case XYFourierFilterCurve::HighPass:
 		switch (form) {
 		case XYFourierFilterCurve::Ideal:
-			for (i = 0; i < cutindex; i++)
-				ydata[i] = 0;
+			for (i = 0; i < cutindex && i < N; i++)
+				gain[i] = 0;
 			break;
 		case XYFourierFilterCurve::Butterworth:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+gsl_sf_pow_int(cutindex/i,2*order));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+gsl_sf_pow_int(cutindex/i,2*order));
 			break;
 		case XYFourierFilterCurve::ChebyshevI:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,cutindex/i),2));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,cutindex/i),2));
 			break;
 		case XYFourierFilterCurve::ChebyshevII:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+1./gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,i/cutindex),2));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+1./gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,i/cutindex),2));
 			break;
 		}
 		break;
 	case XYFourierFilterCurve::BandPass:
 		switch (form) {
 		case XYFourierFilterCurve::Ideal:
-			for (i = 0; i < cutindex; i++)
-				ydata[i] = 0;
-			for (i = cutindex2; i < n; i++)
-				ydata[i] = 0;
+			for (i = 0; i < cutindex && i < N; i++)
+				gain[i] = 0;
+			for (i = cutindex2; i < N; i++)
+				gain[i] = 0;
 			break;
 		case XYFourierFilterCurve::Butterworth:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+gsl_sf_pow_int((i*i-centerindex*centerindex)/i/bandwidth,2*order));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+gsl_sf_pow_int((i*i-centerindex*centerindex)/i/bandwidth,2*order));
 			break;
 		case XYFourierFilterCurve::ChebyshevI:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,(i*i-centerindex*centerindex)/i/bandwidth),2));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,(i*i-centerindex*centerindex)/i/bandwidth),2));
 			break;
 		case XYFourierFilterCurve::ChebyshevII:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+1./gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,i*bandwidth/(i*i-centerindex*centerindex)),2));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+1./gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,i*bandwidth/(i*i-centerindex*centerindex)),2));
 			break;
 		}
 		break;
 	case XYFourierFilterCurve::BandReject:
 		switch (form) {
 		case XYFourierFilterCurve::Ideal:
-			for (i = cutindex; i < cutindex2; i++)
-				ydata[i] = 0;
+			for (i = cutindex; i < cutindex2 && i < N; i++)
+				gain[i] = 0;
 			break;
 		case XYFourierFilterCurve::Butterworth:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+gsl_sf_pow_int(i*bandwidth/(i*i-gsl_sf_pow_int(centerindex,2)),2*order));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+gsl_sf_pow_int(i*bandwidth/(i*i-gsl_sf_pow_int(centerindex,2)),2*order));
 			break;
 		case XYFourierFilterCurve::ChebyshevI:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,i*bandwidth/(i*i-centerindex*centerindex)),2));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,i*bandwidth/(i*i-centerindex*centerindex)),2));
 			break;
 		case XYFourierFilterCurve::ChebyshevII:
-			for (i = 0; i < n; i++)
-				ydata[i] *= 1./sqrt(1.+1./gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,(i*i-centerindex*centerindex)/i/bandwidth),2));
+			for (i = 0; i < N; i++)
+				gain[i] = 1./sqrt(1.+1./gsl_sf_pow_int(nsl_sf_poly_chebyshev_T(order,(i*i-centerindex*centerindex)/i/bandwidth),2));
 			break;
 		}
 		break;
 	}
-
-	// 3. back transform
-	gsl_fft_halfcomplex_wavetable *hc = gsl_fft_halfcomplex_wavetable_alloc (n);
-	status = gsl_fft_halfcomplex_inverse(ydata, 1, n, hc, work);
-	gsl_fft_halfcomplex_wavetable_free (hc);
-	gsl_fft_real_workspace_free (work);
-
-	xVector->resize(n);
-	yVector->resize(n);
-	memcpy(xVector->data(), xdataVector.data(), n*sizeof(double));
-	memcpy(yVector->data(), ydata, n*sizeof(double));
-///////////////////////////////////////////////////////////
-
-	//write the result
-	filterResult.available = true;
-	filterResult.valid = true;
-	filterResult.status = QString(gsl_strerror(status));;
-	filterResult.elapsedTime = timer.elapsed();
-
-	//redraw the curve
-	emit (q->dataChanged());
-	sourceDataChangedSinceLastFilter = false;
 }
 
 //##############################################################################
@@ -438,6 +590,8 @@ void XYFourierFilterCurve::save(QXmlStreamWriter* writer) const{
 	writer->writeAttribute( "unit", QString::number(d->filterData.unit) );
 	writer->writeAttribute( "cutoff2", QString::number(d->filterData.cutoff2) );
 	writer->writeAttribute( "unit2", QString::number(d->filterData.unit2) );
+	writer->writeAttribute( "zeroPadding", QString::number(d->filterData.zeroPadding) );
+	writer->writeAttribute( "streaming", QString::number(d->filterData.streaming) );
 	writer->writeEndElement();// filterData
 
 	//filter results (generated columns)
@@ -527,6 +681,18 @@ bool XYFourierFilterCurve::load(XmlStreamReader* reader) {
 				reader->raiseWarning(attributeWarning.arg("'unit2'"));
 			else
 				d->filterData.unit2 = (XYFourierFilterCurve::CutoffUnit)str.toInt();
+
+			str = attribs.value("zeroPadding").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'zeroPadding'"));
+			else
+				d->filterData.zeroPadding = str.toInt();
+
+			str = attribs.value("streaming").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'streaming'"));
+			else
+				d->filterData.streaming = str.toInt();
 		} else if (reader->name() == "filterResult") {
 
 			attribs = reader->attributes();
@@ -41,7 +41,7 @@ class XYFourierFilterCurve: public XYCurve {
 		enum CutoffUnit {Frequency, Fraction, Index};	// Frequency=0..N/(xmax-xmin), Fraction=0..1, Index=0..N-1
 
 		struct FilterData {
-			FilterData() : type(LowPass), form(Ideal), order(1), cutoff(0), unit(Index), cutoff2(0), unit2(Index) {};
+			FilterData() : type(LowPass), form(Ideal), order(1), cutoff(0), unit(Index), cutoff2(0), unit2(Index), zeroPadding(false), streaming(false) {};
 
 			FilterType type;
 			FilterForm form;
@@ -50,6 +50,8 @@ class XYFourierFilterCurve: public XYCurve {
 			CutoffUnit unit;	// (low) value unit
 			double cutoff2;		// high cutoff
 			CutoffUnit unit2;	// high value unit
+			bool zeroPadding;	// pad the data with zeros to a fast FFT length
+			bool streaming;		// filter chunk by chunk with a causal FIR/IIR filter instead of the FFT
 		};
 		struct FilterResult {
 			FilterResult() : available(false), valid(false), elapsedTime(0) {};
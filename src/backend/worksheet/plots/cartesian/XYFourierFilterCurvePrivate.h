@@ -37,12 +37,19 @@
 
 class XYFourierFilterCurve;
 class Column;
+struct nsl_fft_plan;
+struct nsl_filter_sos;
+struct nsl_filter_fir;
 
 class XYFourierFilterCurvePrivate: public XYCurvePrivate {
 	public:
 		explicit XYFourierFilterCurvePrivate(XYFourierFilterCurve*);
 		~XYFourierFilterCurvePrivate();
 		void recalculate();
+		void updateGain(unsigned int N, double cutindex, double cutindex2);
+		bool filterStreaming();
+		void filterChunk(nsl_filter_sos*, nsl_filter_fir*, QVector<double>& chunk, size_t& skip);
+		bool isValid(int row) const;
 
 		const AbstractColumn* xDataColumn; //<! column storing the values for the x-data to be fitted
 		const AbstractColumn* yDataColumn; //<! column storing the values for the y-data to be fitted
@@ -58,6 +65,9 @@ class XYFourierFilterCurvePrivate: public XYCurvePrivate {
 		QVector<double>* yVector;
 
 		bool sourceDataChangedSinceLastFilter; //<! \c true if the data in the source columns (x, y) was changed, \c false otherwise
+		nsl_fft_plan* fftPlan; //<! FFT plan of the last transform, reused as long as the length doesn't change
+		QVector<double> gain; //<! response of the filter for the halfcomplex data of the last transform
+		QVector<double> gainParameters; //<! type, form, order and cutoff indices the response was calculated for
 
 		XYFourierFilterCurve* const q;
 
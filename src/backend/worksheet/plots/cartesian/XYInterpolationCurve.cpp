@@ -41,16 +41,17 @@
 #include "backend/lib/commandtemplates.h"
 
 #include <cmath>	// isnan
-#include <cfloat>	// DBL_MIN
 extern "C" {
 #include <gsl_errno.h>
 #include <gsl/gsl_interp.h>
 #include <gsl/gsl_spline.h>
+#include "backend/nsl/nsl_interp.h"
 }
 
 #include <KIcon>
 #include <KLocale>
 #include <QElapsedTimer>
+#include <QThreadPool>
 #include <QDebug>
 
 XYInterpolationCurve::XYInterpolationCurve(const QString& name)
@@ -160,6 +161,7 @@ XYInterpolationCurvePrivate::XYInterpolationCurvePrivate(XYInterpolationCurve* o
 	xColumn(0), yColumn(0), 
 	xVector(0), yVector(0), 
 	sourceDataChangedSinceLastInterpolation(false),
+	spline(0), splineType(XYInterpolationCurve::Linear),
 	q(owner)  {
 
 }
@@ -167,6 +169,7 @@ XYInterpolationCurvePrivate::XYInterpolationCurvePrivate(XYInterpolationCurve* o
 XYInterpolationCurvePrivate::~XYInterpolationCurvePrivate() {
 	//no need to delete xColumn and yColumn, they are deleted
 	//when the parent aspect is removed
+	gsl_spline_free(spline);
 }
 
 // ...
@@ -243,51 +246,104 @@ void XYInterpolationCurvePrivate::integ(double *x, double *y, unsigned n) {
 	y[n-1] = y[n-2] + vold;
 }
 
-// calculates rational interpolation of n points of xy-data at xn using Burlisch-Stoer method. result in v (error dv)
-void XYInterpolationCurvePrivate::ratint(double *x, double *y, int n, double xn, double *v, double *dv) {
-	int i,j,a=0,b=n-1;
-	while (b-a > 1) {	// find interval using bisection
-		j = floor((a+b)/2.);
-		if (x[j] > xn)
-			b = j;
-		else
-			a = j;
-	}
-
-	int ns=a;// nearest index
-	if (fabs(xn-x[a]) > fabs(xn-x[b]))
-		ns=b;
+//interpolations with at least this number of output points are evaluated in parallel
+static const unsigned int minParallelInterpolationSize = 100000;
+
+class InterpolationTask : public QRunnable {
+	public:
+		InterpolationTask(XYInterpolationCurvePrivate* d, double* xdata, double* ydata, unsigned int n, double min, double max,
+				double* xresult, double* yresult, unsigned int from, unsigned int to) {
+			m_d = d;
+			m_xdata = xdata;
+			m_ydata = ydata;
+			m_n = n;
+			m_min = min;
+			m_max = max;
+			m_xresult = xresult;
+			m_yresult = yresult;
+			m_from = from;
+			m_to = to;
+		};
+
+		void run() {
+			m_d->evaluateRange(m_xdata, m_ydata, m_n, m_min, m_max, m_xresult, m_yresult, m_from, m_to);
+		}
 
-	if (xn == x[ns]) {	// exact point
-		*v = y[ns];
-		*dv = 0;
-		return;
-	}
+	private:
+		XYInterpolationCurvePrivate* m_d;
+		double* m_xdata;
+		double* m_ydata;
+		unsigned int m_n;
+		double m_min;
+		double m_max;
+		double* m_xresult;
+		double* m_yresult;
+		unsigned int m_from;
+		unsigned int m_to;
+};
 
-	double *c = (double*)malloc(n*sizeof(double));
-	double *d = (double*)malloc(n*sizeof(double));
-	for (i=0; i < n; i++)
-		c[i] = d[i] = y[i];
-
-	*v = y[ns--];
-
-	double t, dd;
-	for (int m=1; m < n; m++) {
-		for (i=0; i < n-m; i++) {
-			t = (x[i]-xn)*d[i]/(x[i+m]-xn);
-			dd = t-c[i+1];
-			if (dd == 0.0) // pole
-				dd += DBL_MIN;
-			dd = (c[i+1]-d[i])/dd;
-			d[i] = c[i+1]*dd;
-			c[i] = t*dd;
+/*!
+ * evaluates the interpolation of the n data points at the output points from..to-1 and writes the x- and y-values
+ * to xresult and yresult. Each call uses its own accelerator, so that ranges can be evaluated in parallel.
+ * The own types are evaluated with the nsl kernels, their derivatives and integral are calculated afterwards
+ * from the complete result.
+ */
+void XYInterpolationCurvePrivate::evaluateRange(double* xdata, double* ydata, unsigned int n, double min, double max,
+		double* xresult, double* yresult, unsigned int from, unsigned int to) {
+	const XYInterpolationCurve::InterpolationEval evaluate = interpolationData.evaluate;
+	const unsigned int npoints = interpolationData.npoints;
+
+	for (unsigned int i = from; i < to; i++)
+		xresult[i] = min + i*(max-min)/(npoints-1);
+
+	switch (interpolationData.type) {
+	case XYInterpolationCurve::Linear:
+	case XYInterpolationCurve::Polynomial:
+	case XYInterpolationCurve::CSpline:
+	case XYInterpolationCurve::CSplinePeriodic:
+	case XYInterpolationCurve::Akima:
+	case XYInterpolationCurve::AkimaPeriodic:
+	case XYInterpolationCurve::Steffen: {
+		gsl_interp_accel *acc = gsl_interp_accel_alloc();
+		for (unsigned int i = from; i < to; i++) {
+			const double x = xresult[i];
+			switch (evaluate) {
+			case XYInterpolationCurve::Function:
+				yresult[i] = gsl_spline_eval(spline, x, acc);
+				break;
+			case XYInterpolationCurve::Derivative:
+				yresult[i] = gsl_spline_eval_deriv(spline, x, acc);
+				break;
+			case XYInterpolationCurve::Derivative2:
+				yresult[i] = gsl_spline_eval_deriv2(spline, x, acc);
+				break;
+			case XYInterpolationCurve::Integral:
+				//integrate from the previous point instead of from the start
+				if (i == from)
+					yresult[i] = gsl_spline_eval_integ(spline, min, x, acc);
+				else
+					yresult[i] = yresult[i-1] + gsl_spline_eval_integ(spline, xresult[i-1], x, acc);
+				break;
+			}
 		}
-
-		*dv = (2*(ns+1) < (n-m) ? c[ns+1] : d[ns--]);
-		*v += *dv;
+		gsl_interp_accel_free(acc);
+		break;
+	}
+	case XYInterpolationCurve::Cosine:
+		nsl_interp_cosine(xdata, ydata, n, min, max, npoints, yresult, from, to);
+		break;
+	case XYInterpolationCurve::Exponential:
+		nsl_interp_exponential(xdata, ydata, n, min, max, npoints, yresult, from, to);
+		break;
+	case XYInterpolationCurve::PCH:
+		nsl_interp_pch(xdata, ydata, n, (nsl_interp_pch_variant)interpolationData.variant, interpolationData.tension,
+			interpolationData.continuity, interpolationData.bias, min, max, npoints, yresult, from, to);
+		break;
+	case XYInterpolationCurve::Rational:
+		//TODO: use the error estimate
+		nsl_interp_rational(xdata, ydata, n, min, max, npoints, yresult, from, to);
+		break;
 	}
-
-	free(c);free(d);
 }
 
 void XYInterpolationCurvePrivate::recalculate() {
@@ -366,188 +422,79 @@ void XYInterpolationCurvePrivate::recalculate() {
 
 	// interpolation settings
 	XYInterpolationCurve::InterpolationType type = interpolationData.type;
-	XYInterpolationCurve::CubicHermiteVariant variant = interpolationData.variant;
-	double tension = interpolationData.tension;
-	double continuity = interpolationData.continuity;
-	double bias = interpolationData.bias;
 	XYInterpolationCurve::InterpolationEval evaluate = interpolationData.evaluate;
 	unsigned int npoints = interpolationData.npoints;
 #ifdef QT_DEBUG
 	qDebug()<<"type:"<<type;
-	qDebug()<<"cubic Hermite variant:"<<variant<<tension<<continuity<<bias;
+	qDebug()<<"cubic Hermite variant:"<<interpolationData.variant<<interpolationData.tension<<interpolationData.continuity<<interpolationData.bias;
 	qDebug()<<"evaluate:"<<evaluate;
 	qDebug()<<"npoints ="<<npoints;
 #endif
 ///////////////////////////////////////////////////////////
 	int status=0;
 
-	gsl_interp_accel *acc = gsl_interp_accel_alloc();
-	gsl_spline *spline=0;
-	switch (type) {
-	case XYInterpolationCurve::Linear:
-		spline = gsl_spline_alloc(gsl_interp_linear, n);
-		status = gsl_spline_init (spline, xdata, ydata, n);
-		break;
-	case XYInterpolationCurve::Polynomial:
-		spline = gsl_spline_alloc(gsl_interp_polynomial, n);
-		status = gsl_spline_init (spline, xdata, ydata, n);
-		break;
-	case XYInterpolationCurve::CSpline:
-		spline = gsl_spline_alloc(gsl_interp_cspline, n);
-		status = gsl_spline_init (spline, xdata, ydata, n);
-		break;
-	case XYInterpolationCurve::CSplinePeriodic:
-		spline = gsl_spline_alloc(gsl_interp_cspline_periodic, n);
-		status = gsl_spline_init (spline, xdata, ydata, n);
-		break;
-	case XYInterpolationCurve::Akima:
-		spline = gsl_spline_alloc(gsl_interp_akima, n);
-		status = gsl_spline_init (spline, xdata, ydata, n);
-		break;
-	case XYInterpolationCurve::AkimaPeriodic:
-		spline = gsl_spline_alloc(gsl_interp_akima_periodic, n);
-		status = gsl_spline_init (spline, xdata, ydata, n);
-		break;
-	case XYInterpolationCurve::Steffen:
-#if GSL_MAJOR_VERSION >= 2
-		spline = gsl_spline_alloc(gsl_interp_steffen, n);
-		status = gsl_spline_init (spline, xdata, ydata, n);
-#endif
-		break;
-	default:
-		break;
+	//the spline is only recalculated if the type or the data changed since the last interpolation
+	if (spline && (splineType != type || spline->size != n || memcmp(spline->x, xdata, n*sizeof(double))
+			|| memcmp(spline->y, ydata, n*sizeof(double)))) {
+		gsl_spline_free(spline);
+		spline = 0;
 	}
-
-	xVector->resize(npoints);
-	yVector->resize(npoints);
-	for (unsigned int i = 0; i < npoints; i++) {
-		unsigned int a=0,b=n-1;
-
-		double x = min + i*(max-min)/(npoints-1);
-		(*xVector)[i] = x;
-
-		// find index a,b for interval [x[a],x[b]] around x[i] using bisection
-		int j=0;
-		switch (type) {
-		case XYInterpolationCurve::Cosine:
-		case XYInterpolationCurve::Exponential:
-		case XYInterpolationCurve::PCH:
-			while (b-a > 1) {
-				j=floor((a+b)/2.);
-				if (xdata[j] > x)
-					b=j;
-				else
-					a=j;
-			}
-			break;
-		default:
-			break;
-		}
-
-		// evaluate interpolation
-		double t;
+	if (!spline) {
+		splineType = type;
 		switch (type) {
 		case XYInterpolationCurve::Linear:
+			spline = gsl_spline_alloc(gsl_interp_linear, n);
+			status = gsl_spline_init (spline, xdata, ydata, n);
+			break;
 		case XYInterpolationCurve::Polynomial:
+			spline = gsl_spline_alloc(gsl_interp_polynomial, n);
+			status = gsl_spline_init (spline, xdata, ydata, n);
+			break;
 		case XYInterpolationCurve::CSpline:
+			spline = gsl_spline_alloc(gsl_interp_cspline, n);
+			status = gsl_spline_init (spline, xdata, ydata, n);
+			break;
 		case XYInterpolationCurve::CSplinePeriodic:
-		case XYInterpolationCurve::Akima:
-		case XYInterpolationCurve::AkimaPeriodic:
-		case XYInterpolationCurve::Steffen:
-			switch (evaluate) {
-			case XYInterpolationCurve::Function:
-				(*yVector)[i] = gsl_spline_eval(spline, x, acc);
-				break;
-			case XYInterpolationCurve::Derivative:
-				(*yVector)[i] = gsl_spline_eval_deriv(spline, x, acc);
-				break;
-			case XYInterpolationCurve::Derivative2:
-				(*yVector)[i] = gsl_spline_eval_deriv2(spline, x, acc);
-				break;
-			case XYInterpolationCurve::Integral:
-				(*yVector)[i] = gsl_spline_eval_integ(spline, min, x, acc);
-				break;
-			}
+			spline = gsl_spline_alloc(gsl_interp_cspline_periodic, n);
+			status = gsl_spline_init (spline, xdata, ydata, n);
 			break;
-		case XYInterpolationCurve::Cosine:
-			t = (x-xdata[a])/(xdata[b]-xdata[a]);
-			t = (1.-cos(M_PI*t))/2.;
-			(*yVector)[i] =  ydata[a] + t*(ydata[b]-ydata[a]);
+		case XYInterpolationCurve::Akima:
+			spline = gsl_spline_alloc(gsl_interp_akima, n);
+			status = gsl_spline_init (spline, xdata, ydata, n);
 			break;
-		case XYInterpolationCurve::Exponential:
-			t = (x-xdata[a])/(xdata[b]-xdata[a]);
-			(*yVector)[i] = ydata[a]*pow(ydata[b]/ydata[a],t);
+		case XYInterpolationCurve::AkimaPeriodic:
+			spline = gsl_spline_alloc(gsl_interp_akima_periodic, n);
+			status = gsl_spline_init (spline, xdata, ydata, n);
 			break;
-		case XYInterpolationCurve::PCH: {
-			t = (x-xdata[a])/(xdata[b]-xdata[a]);
-			double t2=t*t, t3=t2*t;
-			double h1=2.*t3-3.*t2+1, h2=-2.*t3+3.*t2, h3=t3-2*t2+t, h4=t3-t2;
-			double m1=0.,m2=0.;
-			switch (variant) {
-			case XYInterpolationCurve::FiniteDifference:
-				if (a==0)
-					m1=(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-				else
-					m1=( (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) + (ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1]) )/2.;
-				if (b==n-1)
-					m2=(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-				else
-					m2=( (ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) + (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
-
-				break;
-			case XYInterpolationCurve::CatmullRom:
-				if (a==0)
-					m1=(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-				else
-					m1=(ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
-				if (b==n-1)
-					m2=(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-				else
-					m2=(ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
-
-				break;
-			case XYInterpolationCurve::Cardinal:
-				if (a==0)
-					m1=(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-				else
-					m1=(ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
-				m1 *= (1.-tension);
-				if (b==n-1)
-					m2=(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-				else
-					m2=(ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
-				m2 *= (1.-tension);
-
-				break;
-			case XYInterpolationCurve::KochanekBartels:
-				if (a==0)
-					m1=(1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-				else
-					m1=( (1.-continuity)*(1.+bias)*(ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1]) 
-						+ (1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
-				m1 *= (1.-tension);
-				if (b==n-1)
-					m2=(1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-				else
-					m2=( (1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]) 
-						+ (1.-continuity)*(1.-bias)*(ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) )/2.;
-				m2 *= (1.-tension);
-				
-				break;
-			}	
-
-			// Hermite polynomial
-			(*yVector)[i] = ydata[a]*h1+ydata[b]*h2+(xdata[b]-xdata[a])*(m1*h3+m2*h4);
-		}
+		case XYInterpolationCurve::Steffen:
+#if GSL_MAJOR_VERSION >= 2
+			spline = gsl_spline_alloc(gsl_interp_steffen, n);
+			status = gsl_spline_init (spline, xdata, ydata, n);
+#endif
 			break;
-		case XYInterpolationCurve::Rational: {
-			double v,dv;
-			ratint(xdata, ydata, n, x, &v, &dv);
-			(*yVector)[i] = v;
-			//TODO: use dv
+		default:
 			break;
 		}
+	}
+
+	xVector->resize(npoints);
+	yVector->resize(npoints);
+	//evaluate many points in blocks on all available threads, each with its own accelerator
+	double* xresult = xVector->data();
+	double* yresult = yVector->data();
+	QThreadPool* pool = QThreadPool::globalInstance();
+	const unsigned int blocks = (npoints < minParallelInterpolationSize) ? 1 : qMax(pool->maxThreadCount(), 1);
+	if (blocks == 1)
+		evaluateRange(xdata, ydata, n, min, max, xresult, yresult, 0, npoints);
+	else {
+		const unsigned int range = (npoints + blocks - 1)/blocks;
+		for (unsigned int i=0; i<blocks; ++i) {
+			const unsigned int start = i*range;
+			const unsigned int end = qMin((i+1)*range, npoints);
+			if (start < end)
+				pool->start(new InterpolationTask(this, xdata, ydata, n, min, max, xresult, yresult, start, end));
 		}
+		pool->waitForDone();
 	}
 
 	// calculate "evaluate" option for own types
@@ -582,8 +529,11 @@ void XYInterpolationCurvePrivate::recalculate() {
 			(*yVector)[i] = CartesianCoordinateSystem::Scale::LIMIT_MIN;
 	}
 
-	gsl_spline_free(spline);
-	gsl_interp_accel_free(acc);
+	//don't keep a spline that couldn't be initialized
+	if (status) {
+		gsl_spline_free(spline);
+		spline = 0;
+	}
 
 ///////////////////////////////////////////////////////////
 
@@ -32,6 +32,8 @@
 #include "backend/worksheet/plots/cartesian/XYCurvePrivate.h"
 #include "backend/worksheet/plots/cartesian/XYInterpolationCurve.h"
 
+#include <gsl/gsl_spline.h>
+
 class XYInterpolationCurve;
 class Column;
 
@@ -41,6 +43,8 @@ class XYInterpolationCurvePrivate: public XYCurvePrivate {
 		~XYInterpolationCurvePrivate();
 
 		void recalculate();
+		void evaluateRange(double* xdata, double* ydata, unsigned int n, double min, double max,
+			double* xresult, double* yresult, unsigned int from, unsigned int to);
 
 		const AbstractColumn* xDataColumn; //<! column storing the values for the x-data to be interpolated
 		const AbstractColumn* yDataColumn; //<! column storing the values for the y-data to be interpolated
@@ -56,6 +60,8 @@ class XYInterpolationCurvePrivate: public XYCurvePrivate {
 		QVector<double>* yVector;
 
 		bool sourceDataChangedSinceLastInterpolation; //<! \c true if the data in the source columns (x, y) was changed, \c false otherwise
+		gsl_spline* spline; //<! spline of the last interpolation, reused as long as the data and the type don't change
+		XYInterpolationCurve::InterpolationType splineType; //<! type the spline was calculated for
 
 		XYInterpolationCurve* const q;
 
@@ -63,7 +69,6 @@ class XYInterpolationCurvePrivate: public XYCurvePrivate {
 		void deriv(double *x, double *y, unsigned n);
 		void deriv2(double *x, double *y, unsigned n);
 		void integ(double *x, double *y, unsigned n);
-		void ratint(double *x, double *y, int n, double xn, double *v, double *dv);
 };
 
 #endif
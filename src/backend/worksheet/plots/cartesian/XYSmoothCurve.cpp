@@ -43,6 +43,7 @@
 #include <KIcon>
 #include <KLocale>
 #include <QElapsedTimer>
+#include <QThreadPool>
 #include <QDebug>
 
 extern "C" {
@@ -170,6 +171,51 @@ XYSmoothCurvePrivate::~XYSmoothCurvePrivate() {
 // ...
 // see XYFitCurvePrivate
 
+//signals with at least this number of points are smoothed in parallel
+static const unsigned int minParallelSmoothSize = 100000;
+
+/*!
+ * smooths the n values in data and writes the results from..to-1 into result (see the *_range() functions in nsl_smooth.h)
+ */
+static int smoothRange(const XYSmoothCurve::SmoothData& smoothData, const double* data, unsigned int n, double* result, unsigned int from, unsigned int to) {
+	switch (smoothData.type) {
+	case XYSmoothCurve::MovingAverage:
+		return nsl_smooth_moving_average_range(data, n, smoothData.points, smoothData.weight, smoothData.mode, result, from, to);
+	case XYSmoothCurve::MovingAverageLagged:
+		return nsl_smooth_moving_average_lagged_range(data, n, smoothData.points, smoothData.weight, smoothData.mode, result, from, to);
+	case XYSmoothCurve::Percentile:
+		return nsl_smooth_percentile_range(data, n, smoothData.points, smoothData.percentile, smoothData.mode, result, from, to);
+	case XYSmoothCurve::SavitzkyGolay:
+		return nsl_smooth_savgol_range(data, n, smoothData.points, smoothData.order, 0, smoothData.mode, result, from, to);
+	}
+
+	return 0;
+}
+
+class SmoothTask : public QRunnable {
+	public:
+		SmoothTask(const XYSmoothCurve::SmoothData& smoothData, const double* data, unsigned int n, double* result, unsigned int from, unsigned int to) {
+			m_smoothData = smoothData;
+			m_data = data;
+			m_n = n;
+			m_result = result;
+			m_from = from;
+			m_to = to;
+		};
+
+		void run() {
+			smoothRange(m_smoothData, m_data, m_n, m_result, m_from, m_to);
+		}
+
+	private:
+		XYSmoothCurve::SmoothData m_smoothData;
+		const double* m_data;
+		unsigned int m_n;
+		double* m_result;
+		unsigned int m_from;
+		unsigned int m_to;
+};
+
 void XYSmoothCurvePrivate::recalculate() {
 	QElapsedTimer timer;
 	timer.start();
@@ -242,47 +288,43 @@ void XYSmoothCurvePrivate::recalculate() {
 	double* ydata = ydataVector.data();
 
 	// smooth settings
-	XYSmoothCurve::SmoothType type = smoothData.type;
-	unsigned int points = smoothData.points;
-	nsl_smooth_weight_type weight = smoothData.weight;
-	double percentile = smoothData.percentile;
-	unsigned int order = smoothData.order;
-	nsl_smooth_pad_mode mode = smoothData.mode;
-	double lvalue = smoothData.lvalue;
-	double rvalue = smoothData.rvalue;
 #ifdef QT_DEBUG
-	qDebug()<<"type:"<<type;
-	qDebug()<<"points ="<<points;
-	qDebug()<<"weight:"<<weight;
-	qDebug()<<"percentile ="<<percentile;
-	qDebug()<<"order ="<<order;
-	qDebug()<<"mode ="<<mode;
-	qDebug()<<"const. values ="<<lvalue<<rvalue;
+	qDebug()<<"type:"<<smoothData.type;
+	qDebug()<<"points ="<<smoothData.points;
+	qDebug()<<"weight:"<<smoothData.weight;
+	qDebug()<<"percentile ="<<smoothData.percentile;
+	qDebug()<<"order ="<<smoothData.order;
+	qDebug()<<"mode ="<<smoothData.mode;
+	qDebug()<<"const. values ="<<smoothData.lvalue<<smoothData.rvalue;
 #endif
 ///////////////////////////////////////////////////////////
-	int status=0;
-
-	switch (type) {
-	case XYSmoothCurve::MovingAverage:
-		status = nsl_smooth_moving_average(ydata, n, points, weight, mode);
-		break;
-	case XYSmoothCurve::MovingAverageLagged:
-		status = nsl_smooth_moving_average_lagged(ydata, n, points, weight, mode);
-		break;
-	case XYSmoothCurve::Percentile:
-		status = nsl_smooth_percentile(ydata, n, points, percentile, mode);
-		break;
-	case XYSmoothCurve::SavitzkyGolay:
-		if (mode == nsl_smooth_pad_constant)
-			nsl_smooth_pad_constant_set(lvalue, rvalue);
-		status = nsl_smooth_savgol(ydata, n, points, order, mode);
-		break;
-	}
+	if (smoothData.mode == nsl_smooth_pad_constant)
+		nsl_smooth_pad_constant_set(smoothData.lvalue, smoothData.rvalue);
 
 	xVector->resize(n);
 	yVector->resize(n);
 	memcpy(xVector->data(), xdata, n*sizeof(double));
-	memcpy(yVector->data(), ydata, n*sizeof(double));
+
+	//check the parameters with an empty range first, this also caches the Savitzky-Golay coefficients for the blocks
+	int status = smoothRange(smoothData, ydata, n, yVector->data(), 0, 0);
+	if (!status) {
+		//smooth long signals in blocks on all available threads, the result doesn't depend on the partitioning
+		QThreadPool* pool = QThreadPool::globalInstance();
+		const unsigned int blocks = (n < minParallelSmoothSize) ? 1 : qMax(pool->maxThreadCount(), 1);
+		if (blocks == 1)
+			smoothRange(smoothData, ydata, n, yVector->data(), 0, n);
+		else {
+			const unsigned int range = (n + blocks - 1)/blocks;
+			for (unsigned int i=0; i<blocks; ++i) {
+				const unsigned int start = i*range;
+				const unsigned int end = qMin((i+1)*range, n);
+				if (start < end)
+					pool->start(new SmoothTask(smoothData, ydata, n, yVector->data(), start, end));
+			}
+			pool->waitForDone();
+		}
+	} else
+		memcpy(yVector->data(), ydata, n*sizeof(double));
 
 ///////////////////////////////////////////////////////////
 
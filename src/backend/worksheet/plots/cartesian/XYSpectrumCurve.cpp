@@ -0,0 +1,641 @@
+/***************************************************************************
+    File                 : XYSpectrumCurve.cpp
+    Project              : LabPlot
+    Description          : A xy-curve defined by a power spectrum
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+/*!
+  \class XYSpectrumCurve
+  \brief A xy-curve defined by a power spectrum
+
+  The curve shows the one-sided power spectral density of the y-data (periodogram or Welch's
+  average of the spectra of overlapping windowed segments). The x-data is assumed to be equidistant,
+  it determines the sample rate. The spectra of all segments can be exported into a matrix (spectrogram).
+
+  \ingroup worksheet
+*/
+
+#include "XYSpectrumCurve.h"
+#include "XYSpectrumCurvePrivate.h"
+#include "backend/core/AbstractColumn.h"
+#include "backend/core/column/Column.h"
+#include "backend/matrix/Matrix.h"
+#include "backend/lib/commandtemplates.h"
+
+#include <cmath>	// isnan
+extern "C" {
+#include <gsl/gsl_errno.h>
+#include "backend/nsl/nsl_fft.h"
+#include "backend/nsl/nsl_spectrum.h"
+}
+
+#include <KIcon>
+#include <KLocale>
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+XYSpectrumCurve::XYSpectrumCurve(const QString& name)
+		: XYCurve(name, new XYSpectrumCurvePrivate(this)) {
+	init();
+}
+
+XYSpectrumCurve::XYSpectrumCurve(const QString& name, XYSpectrumCurvePrivate* dd)
+		: XYCurve(name, dd) {
+	init();
+}
+
+
+XYSpectrumCurve::~XYSpectrumCurve() {
+	//no need to delete the d-pointer here - it inherits from QGraphicsItem
+	//and is deleted during the cleanup in QGraphicsScene
+}
+
+void XYSpectrumCurve::init() {
+	Q_D(XYSpectrumCurve);
+
+	//TODO: read from the saved settings for XYSpectrumCurve?
+	d->lineType = XYCurve::Line;
+	d->symbolsStyle = Symbol::NoSymbols;
+}
+
+void XYSpectrumCurve::recalculate() {
+	Q_D(XYSpectrumCurve);
+	d->recalculate();
+}
+
+/*!
+	Returns an icon to be used in the project explorer.
+*/
+QIcon XYSpectrumCurve::icon() const {
+	return KIcon("labplot-xy-spectrum-curve");
+}
+
+//##############################################################################
+//##########################  getter methods  ##################################
+//##############################################################################
+BASIC_SHARED_D_READER_IMPL(XYSpectrumCurve, const AbstractColumn*, xDataColumn, xDataColumn)
+BASIC_SHARED_D_READER_IMPL(XYSpectrumCurve, const AbstractColumn*, yDataColumn, yDataColumn)
+const QString& XYSpectrumCurve::xDataColumnPath() const { Q_D(const XYSpectrumCurve); return d->xDataColumnPath; }
+const QString& XYSpectrumCurve::yDataColumnPath() const { Q_D(const XYSpectrumCurve); return d->yDataColumnPath; }
+
+BASIC_SHARED_D_READER_IMPL(XYSpectrumCurve, XYSpectrumCurve::SpectrumData, spectrumData, spectrumData)
+
+const XYSpectrumCurve::SpectrumResult& XYSpectrumCurve::spectrumResult() const {
+	Q_D(const XYSpectrumCurve);
+	return d->spectrumResult;
+}
+
+bool XYSpectrumCurve::isSourceDataChangedSinceLastSpectrum() const {
+	Q_D(const XYSpectrumCurve);
+	return d->sourceDataChangedSinceLastSpectrum;
+}
+
+//##############################################################################
+//#################  setter methods and undo commands ##########################
+//##############################################################################
+STD_SETTER_CMD_IMPL_S(XYSpectrumCurve, SetXDataColumn, const AbstractColumn*, xDataColumn)
+void XYSpectrumCurve::setXDataColumn(const AbstractColumn* column) {
+	Q_D(XYSpectrumCurve);
+	if (column != d->xDataColumn) {
+		exec(new XYSpectrumCurveSetXDataColumnCmd(d, column, i18n("%1: assign x-data")));
+		emit sourceDataChangedSinceLastSpectrum();
+		if (column) {
+			connect(column, SIGNAL(dataChanged(const AbstractColumn*)), this, SLOT(handleSourceDataChanged()));
+			//TODO disconnect on undo
+		}
+	}
+}
+
+STD_SETTER_CMD_IMPL_S(XYSpectrumCurve, SetYDataColumn, const AbstractColumn*, yDataColumn)
+void XYSpectrumCurve::setYDataColumn(const AbstractColumn* column) {
+	Q_D(XYSpectrumCurve);
+	if (column != d->yDataColumn) {
+		exec(new XYSpectrumCurveSetYDataColumnCmd(d, column, i18n("%1: assign y-data")));
+		emit sourceDataChangedSinceLastSpectrum();
+		if (column) {
+			connect(column, SIGNAL(dataChanged(const AbstractColumn*)), this, SLOT(handleSourceDataChanged()));
+			//TODO disconnect on undo
+		}
+	}
+}
+
+STD_SETTER_CMD_IMPL_F_S(XYSpectrumCurve, SetSpectrumData, XYSpectrumCurve::SpectrumData, spectrumData, recalculate);
+void XYSpectrumCurve::setSpectrumData(const XYSpectrumCurve::SpectrumData& spectrumData) {
+	Q_D(XYSpectrumCurve);
+	exec(new XYSpectrumCurveSetSpectrumDataCmd(d, spectrumData, i18n("%1: set spectrum options and calculate the spectrum")));
+}
+
+/*!
+ * calculates the spectra of all segments of the y-data and returns them in a new matrix
+ * (one column per segment, one row per frequency) or 0 if the spectrogram can't be calculated.
+ * The matrix is not added to the project.
+ */
+Matrix* XYSpectrumCurve::createSpectrogram() {
+	Q_D(XYSpectrumCurve);
+	if (!d->xDataColumn || !d->yDataColumn || d->xDataColumn->rowCount() != d->yDataColumn->rowCount())
+		return 0;
+
+	QVector<double> ydata;
+	double xmin, xmax;
+	QString status;
+	if (!d->sourceData(ydata, xmin, xmax, status))
+		return 0;
+
+	const unsigned int n = ydata.size();
+	const unsigned int segment = d->spectrumData.segmentLength;
+	const unsigned int overlap = d->spectrumData.overlap;
+	const unsigned int count = nsl_spectrum_segment_count(n, segment, overlap);
+	if (segment < 2 || count == 0)
+		return 0;
+
+	const unsigned int bins = segment/2 + 1;
+	QVector<QVector<double> > columns(count);
+	for (unsigned int i=0; i<count; ++i)
+		columns[i].resize(bins);
+	if (!d->analyze(ydata.constData(), segment, segment - overlap, count, 0, &columns))
+		return 0;
+
+	//density per frequency unit
+	const double fs = (xmax > xmin) ? (n-1)/(xmax-xmin) : 1.;
+	for (unsigned int i=0; i<count; ++i) {
+		double* psd = columns[i].data();
+		for (unsigned int k=0; k<bins; ++k)
+			psd[k] = d->spectrumData.decibel ? 10.*log10(psd[k]/fs) : psd[k]/fs;
+	}
+
+	Matrix* matrix = new Matrix(0, bins, count, i18n("Spectrogram of %1", name()));
+	matrix->setData(columns);
+	//x: centers of the segments, y: frequencies
+	const unsigned int step = segment - overlap;
+	matrix->setCoordinates(xmin + (segment-1)/2./fs, xmin + ((count-1)*step + (segment-1)/2.)/fs, 0, fs*(bins-1)/segment);
+
+	return matrix;
+}
+
+//##############################################################################
+//################################## SLOTS ####################################
+//##############################################################################
+void XYSpectrumCurve::handleSourceDataChanged() {
+	Q_D(XYSpectrumCurve);
+	d->sourceDataChangedSinceLastSpectrum = true;
+	emit sourceDataChangedSinceLastSpectrum();
+}
+//##############################################################################
+//######################### Private implementation #############################
+//##############################################################################
+XYSpectrumCurvePrivate::XYSpectrumCurvePrivate(XYSpectrumCurve* owner) : XYCurvePrivate(owner),
+	xDataColumn(0), yDataColumn(0),
+	xColumn(0), yColumn(0),
+	xVector(0), yVector(0),
+	sourceDataChangedSinceLastSpectrum(false),
+	q(owner) {
+
+}
+
+XYSpectrumCurvePrivate::~XYSpectrumCurvePrivate() {
+	//no need to delete xColumn and yColumn, they are deleted
+	//when the parent aspect is removed
+	foreach (nsl_fft_plan* plan, fftPlans)
+		nsl_fft_plan_free(plan);
+}
+
+//signals with at least this number of segments are analyzed in parallel
+static const unsigned int minParallelSegments = 16;
+
+/*!
+ * calculates the spectra of the segments first..last-1 with its own plan and work space.
+ * The spectra are either added to sum or written to spectra (one array per segment).
+ */
+class SpectrumTask : public QRunnable {
+	public:
+		SpectrumTask(nsl_fft_plan* plan, const double* data, unsigned int step, const double* window, double wnorm,
+				unsigned int first, unsigned int last, double* sum, double* const* spectra) {
+			m_plan = plan;
+			m_data = data;
+			m_step = step;
+			m_window = window;
+			m_wnorm = wnorm;
+			m_first = first;
+			m_last = last;
+			m_sum = sum;
+			m_spectra = spectra;
+			m_status = GSL_SUCCESS;
+		};
+
+		void run() {
+			QVector<double> work(nsl_fft_plan_size(m_plan));
+			if (m_spectra) {
+				for (unsigned int i=m_first; i<m_last && m_status==GSL_SUCCESS; ++i)
+					m_status = nsl_spectrum_segment(m_plan, m_data + (size_t)i*m_step, m_window, m_wnorm, work.data(), m_spectra[i]);
+			} else
+				m_status = nsl_spectrum_welch_sum(m_plan, m_data, m_step, m_window, m_wnorm, m_first, m_last, work.data(), m_sum);
+		}
+
+		int status() const {
+			return m_status;
+		}
+
+	private:
+		nsl_fft_plan* m_plan;
+		const double* m_data;
+		unsigned int m_step;
+		const double* m_window;
+		double m_wnorm;
+		unsigned int m_first;
+		unsigned int m_last;
+		double* m_sum;
+		double* const* m_spectra;
+		int m_status;
+};
+
+/*!
+ * copies the valid y-values to ydata and determines the range of the x-values.
+ * Returns \c false and sets status if there is no data.
+ */
+bool XYSpectrumCurvePrivate::sourceData(QVector<double>& ydata, double& xmin, double& xmax, QString& status) const {
+	const int rows = xDataColumn->rowCount();
+	ydata.reserve(rows);
+	for (int row=0; row<rows; ++row) {
+		//only copy those data where _all_ values (for x and y, if given) are valid
+		const double x = xDataColumn->valueAt(row);
+		const double y = yDataColumn->valueAt(row);
+		if (!std::isnan(x) && !std::isnan(y) && !xDataColumn->isMasked(row) && !yDataColumn->isMasked(row))
+			ydata.append(y);
+	}
+
+	if (ydata.isEmpty()) {
+		status = i18n("No data points available.");
+		return false;
+	}
+
+	xmin = xDataColumn->minimum();
+	xmax = xDataColumn->maximum();
+	return true;
+}
+
+/*!
+ * calculates the spectra of count segments of length segment starting step points apart in data.
+ * The spectra are summed up in sum (segment/2+1 values) or written to the columns (one per segment, resized by the caller).
+ * Long signals are split into blocks of segments analyzed on all available threads, each with its own FFT plan.
+ * The sum doesn't depend on the number of threads up to rounding.
+ */
+bool XYSpectrumCurvePrivate::analyze(const double* data, unsigned int segment, unsigned int step, unsigned int count,
+		QVector<double>* sum, QVector<QVector<double> >* columns) {
+	QThreadPool* pool = QThreadPool::globalInstance();
+	const unsigned int blocks = (count < minParallelSegments) ? 1 : qMin((unsigned int)qMax(pool->maxThreadCount(), 1), count);
+
+	//the plans are created here since planning is not thread-safe (FFTW)
+	if (!fftPlans.isEmpty() && nsl_fft_plan_size(fftPlans.first()) != segment) {
+		foreach (nsl_fft_plan* plan, fftPlans)
+			nsl_fft_plan_free(plan);
+		fftPlans.clear();
+	}
+	while ((unsigned int)fftPlans.size() < blocks) {
+		nsl_fft_plan* plan = nsl_fft_plan_alloc(segment);
+		if (!plan)
+			return false;
+		fftPlans.append(plan);
+	}
+
+	QVector<double> window(segment);
+	nsl_spectrum_window(window.data(), segment, (nsl_spectrum_window_type)spectrumData.window);
+	double wnorm = 0;
+	for (unsigned int j=0; j<segment; ++j)
+		wnorm += window[j]*window[j];
+
+	const unsigned int bins = segment/2 + 1;
+	QVector<double> sums(sum ? blocks*bins : 0, 0.);
+	QVector<double*> spectra;
+	if (columns)
+		for (unsigned int i=0; i<count; ++i)
+			spectra.append((*columns)[i].data());
+	QVector<SpectrumTask*> tasks;
+	const unsigned int range = (count + blocks - 1)/blocks;
+	for (unsigned int i=0; i<blocks; ++i) {
+		const unsigned int first = i*range;
+		const unsigned int last = qMin((i+1)*range, count);
+		if (first >= last)
+			break;
+
+		SpectrumTask* task = new SpectrumTask(fftPlans.at(i), data, step, window.constData(), wnorm, first, last,
+			sum ? sums.data() + i*bins : 0, columns ? spectra.constData() : 0);
+		task->setAutoDelete(false);
+		tasks.append(task);
+	}
+
+	if (tasks.size() == 1)
+		tasks.first()->run();
+	else {
+		foreach (SpectrumTask* task, tasks)
+			pool->start(task);
+		pool->waitForDone();
+	}
+
+	//sum up the blocks in a fixed order
+	bool success = true;
+	if (sum)
+		sum->fill(0., bins);
+	for (int i=0; i<tasks.size(); ++i) {
+		success = success && (tasks.at(i)->status() == GSL_SUCCESS);
+		if (sum)
+			for (unsigned int k=0; k<bins; ++k)
+				(*sum)[k] += sums[i*bins + k];
+		delete tasks.at(i);
+	}
+
+	return success;
+}
+
+void XYSpectrumCurvePrivate::recalculate() {
+#ifndef NDEBUG
+	qDebug()<<"XYSpectrumCurvePrivate::recalculate()";
+#endif
+	QElapsedTimer timer;
+	timer.start();
+
+	//create spectrum result columns if not available yet, clear them otherwise
+	if (!xColumn) {
+		xColumn = new Column("x", AbstractColumn::Numeric);
+		yColumn = new Column("y", AbstractColumn::Numeric);
+		xVector = static_cast<QVector<double>* >(xColumn->data());
+		yVector = static_cast<QVector<double>* >(yColumn->data());
+
+		xColumn->setHidden(true);
+		q->addChild(xColumn);
+		yColumn->setHidden(true);
+		q->addChild(yColumn);
+
+		q->setUndoAware(false);
+		q->setXColumn(xColumn);
+		q->setYColumn(yColumn);
+		q->setUndoAware(true);
+	} else {
+		xVector->clear();
+		yVector->clear();
+	}
+
+	// clear the previous result
+	spectrumResult = XYSpectrumCurve::SpectrumResult();
+
+	if (!xDataColumn || !yDataColumn) {
+		emit (q->dataChanged());
+		sourceDataChangedSinceLastSpectrum = false;
+		return;
+	}
+
+	//check column sizes
+	if (xDataColumn->rowCount()!=yDataColumn->rowCount()) {
+		spectrumResult.available = true;
+		spectrumResult.valid = false;
+		spectrumResult.status = i18n("Number of x and y data points must be equal.");
+		emit (q->dataChanged());
+		sourceDataChangedSinceLastSpectrum = false;
+		return;
+	}
+
+	//copy all valid data points to a temporary vector
+	QVector<double> ydataVector;
+	double xmin, xmax;
+	if (!sourceData(ydataVector, xmin, xmax, spectrumResult.status)) {
+		spectrumResult.available = true;
+		spectrumResult.valid = false;
+		emit (q->dataChanged());
+		sourceDataChangedSinceLastSpectrum = false;
+		return;
+	}
+
+	//the periodogram is the spectrum of all data as one segment
+	const unsigned int n = ydataVector.size();
+	const bool periodogram = (spectrumData.method == XYSpectrumCurve::Periodogram);
+	const unsigned int segment = periodogram ? n : spectrumData.segmentLength;
+	const unsigned int overlap = periodogram ? 0 : spectrumData.overlap;
+	const unsigned int count = nsl_spectrum_segment_count(n, segment, overlap);
+#ifndef NDEBUG
+	qDebug()<<"n ="<<n<<", segment length ="<<segment<<", overlap ="<<overlap<<", segments ="<<count;
+	qDebug()<<"window :"<<spectrumData.window;
+#endif
+	if (segment < 2 || count == 0) {
+		spectrumResult.available = true;
+		spectrumResult.valid = false;
+		spectrumResult.status = i18n("The segment length must be between 2 and the number of data points and larger than the overlap.");
+		emit (q->dataChanged());
+		sourceDataChangedSinceLastSpectrum = false;
+		return;
+	}
+
+///////////////////////////////////////////////////////////
+	const unsigned int bins = segment/2 + 1;
+	QVector<double> psd(bins);
+	if (!analyze(ydataVector.constData(), segment, segment - overlap, count, &psd, 0)) {
+		spectrumResult.available = true;
+		spectrumResult.valid = false;
+		spectrumResult.status = i18n("Failed to allocate the FFT.");
+		emit (q->dataChanged());
+		sourceDataChangedSinceLastSpectrum = false;
+		return;
+	}
+
+	//average of the segments, density per frequency unit for the sample rate given by the x-data
+	const double fs = (xmax > xmin) ? (n-1)/(xmax-xmin) : 1.;
+	xVector->resize(bins);
+	yVector->resize(bins);
+	for (unsigned int k=0; k<bins; ++k) {
+		const double density = psd[k]/count/fs;
+		(*xVector)[k] = k*fs/segment;
+		(*yVector)[k] = spectrumData.decibel ? 10.*log10(density) : density;
+	}
+///////////////////////////////////////////////////////////
+
+	//write the result
+	spectrumResult.available = true;
+	spectrumResult.valid = true;
+	spectrumResult.status = QString(gsl_strerror(GSL_SUCCESS));
+	spectrumResult.elapsedTime = timer.elapsed();
+
+	//redraw the curve
+	emit (q->dataChanged());
+	sourceDataChangedSinceLastSpectrum = false;
+}
+
+//##############################################################################
+//##################  Serialization/Deserialization  ###########################
+//##############################################################################
+//! Save as XML
+void XYSpectrumCurve::save(QXmlStreamWriter* writer) const{
+	Q_D(const XYSpectrumCurve);
+
+	writer->writeStartElement("xySpectrumCurve");
+
+	//write xy-curve information
+	XYCurve::save(writer);
+
+	//write xy-spectrum-curve specific information
+	//spectrum data
+	writer->writeStartElement("spectrumData");
+	WRITE_COLUMN(d->xDataColumn, xDataColumn);
+	WRITE_COLUMN(d->yDataColumn, yDataColumn);
+	writer->writeAttribute( "method", QString::number(d->spectrumData.method) );
+	writer->writeAttribute( "window", QString::number(d->spectrumData.window) );
+	writer->writeAttribute( "segmentLength", QString::number(d->spectrumData.segmentLength) );
+	writer->writeAttribute( "overlap", QString::number(d->spectrumData.overlap) );
+	writer->writeAttribute( "decibel", QString::number(d->spectrumData.decibel) );
+	writer->writeEndElement();// spectrumData
+
+	//spectrum results (generated columns)
+	writer->writeStartElement("spectrumResult");
+	writer->writeAttribute( "available", QString::number(d->spectrumResult.available) );
+	writer->writeAttribute( "valid", QString::number(d->spectrumResult.valid) );
+	writer->writeAttribute( "status", d->spectrumResult.status );
+	writer->writeAttribute( "time", QString::number(d->spectrumResult.elapsedTime) );
+
+	//save calculated columns if available
+	if (d->xColumn) {
+		d->xColumn->save(writer);
+		d->yColumn->save(writer);
+	}
+	writer->writeEndElement(); //"spectrumResult"
+	writer->writeEndElement(); //"xySpectrumCurve"
+}
+
+//! Load from XML
+bool XYSpectrumCurve::load(XmlStreamReader* reader) {
+	Q_D(XYSpectrumCurve);
+
+	if (!reader->isStartElement() || reader->name() != "xySpectrumCurve") {
+		reader->raiseError(i18n("no xy spectrum curve element found"));
+		return false;
+	}
+
+	QString attributeWarning = i18n("Attribute '%1' missing or empty, default value is used");
+	QXmlStreamAttributes attribs;
+	QString str;
+
+	while (!reader->atEnd()) {
+		reader->readNext();
+		if (reader->isEndElement() && reader->name() == "xySpectrumCurve")
+			break;
+
+		if (!reader->isStartElement())
+			continue;
+
+		if (reader->name() == "xyCurve") {
+			if ( !XYCurve::load(reader) )
+				return false;
+		} else if (reader->name() == "spectrumData") {
+			attribs = reader->attributes();
+
+			READ_COLUMN(xDataColumn);
+			READ_COLUMN(yDataColumn);
+
+			str = attribs.value("method").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'method'"));
+			else
+				d->spectrumData.method = (XYSpectrumCurve::SpectrumMethod)str.toInt();
+
+			str = attribs.value("window").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'window'"));
+			else
+				d->spectrumData.window = (XYSpectrumCurve::WindowType)str.toInt();
+
+			str = attribs.value("segmentLength").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'segmentLength'"));
+			else
+				d->spectrumData.segmentLength = str.toUInt();
+
+			str = attribs.value("overlap").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'overlap'"));
+			else
+				d->spectrumData.overlap = str.toUInt();
+
+			str = attribs.value("decibel").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'decibel'"));
+			else
+				d->spectrumData.decibel = str.toInt();
+		} else if (reader->name() == "spectrumResult") {
+
+			attribs = reader->attributes();
+
+			str = attribs.value("available").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'available'"));
+			else
+				d->spectrumResult.available = str.toInt();
+
+			str = attribs.value("valid").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'valid'"));
+			else
+				d->spectrumResult.valid = str.toInt();
+			
+			str = attribs.value("status").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'status'"));
+			else
+				d->spectrumResult.status = str;
+
+			str = attribs.value("time").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.arg("'time'"));
+			else
+				d->spectrumResult.elapsedTime = str.toInt();
+		} else if (reader->name() == "column") {
+			Column* column = new Column("", AbstractColumn::Numeric);
+			if (!column->load(reader)) {
+				delete column;
+				return false;
+			}
+
+			if (column->name()=="x")
+				d->xColumn = column;
+			else if (column->name()=="y")
+				d->yColumn = column;
+		}
+	}
+
+	if (d->xColumn && d->yColumn) {
+		d->xColumn->setHidden(true);
+		addChild(d->xColumn);
+
+		d->yColumn->setHidden(true);
+		addChild(d->yColumn);
+
+		d->xVector = static_cast<QVector<double>* >(d->xColumn->data());
+		d->yVector = static_cast<QVector<double>* >(d->yColumn->data());
+
+		setUndoAware(false);
+		XYCurve::d_ptr->xColumn = d->xColumn;
+		XYCurve::d_ptr->yColumn = d->yColumn;
+		setUndoAware(true);
+	} else {
+		qWarning()<<"	d->xColumn == NULL!";
+	}
+
+	return true;
+}
@@ -0,0 +1,103 @@
+/***************************************************************************
+    File                 : XYSpectrumCurve.h
+    Project              : LabPlot
+    Description          : A xy-curve defined by a power spectrum
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef XYSPECTRUMCURVE_H
+#define XYSPECTRUMCURVE_H
+
+#include "backend/worksheet/plots/cartesian/XYCurve.h"
+
+class Matrix;
+class XYSpectrumCurvePrivate;
+class XYSpectrumCurve: public XYCurve {
+	Q_OBJECT
+
+	public:
+		enum SpectrumMethod {Periodogram, Welch};	// Welch=average of the spectra of overlapping segments
+		enum WindowType {RectangularWindow, TriangularWindow, WelchWindow, HannWindow, HammingWindow, BlackmanWindow};
+
+		struct SpectrumData {
+			SpectrumData() : method(Welch), window(HannWindow), segmentLength(1024), overlap(512), decibel(false) {};
+
+			SpectrumMethod method;
+			WindowType window;
+			unsigned int segmentLength;	// number of points of a segment (Welch and spectrogram)
+			unsigned int overlap;		// number of points of overlapping segments
+			bool decibel;			// show 10*log10 of the power spectral density
+		};
+		struct SpectrumResult {
+			SpectrumResult() : available(false), valid(false), elapsedTime(0) {};
+
+			bool available;
+			bool valid;
+			QString status;
+			qint64 elapsedTime;
+		};
+
+		explicit XYSpectrumCurve(const QString& name);
+		virtual ~XYSpectrumCurve();
+
+		void recalculate();
+		Matrix* createSpectrogram();
+		virtual QIcon icon() const;
+		virtual void save(QXmlStreamWriter*) const;
+		virtual bool load(XmlStreamReader*);
+
+		POINTER_D_ACCESSOR_DECL(const AbstractColumn, xDataColumn, XDataColumn)
+		POINTER_D_ACCESSOR_DECL(const AbstractColumn, yDataColumn, YDataColumn)
+		const QString& xDataColumnPath() const;
+		const QString& yDataColumnPath() const;
+
+		CLASS_D_ACCESSOR_DECL(SpectrumData, spectrumData, SpectrumData)
+		const SpectrumResult& spectrumResult() const;
+		bool isSourceDataChangedSinceLastSpectrum() const;
+
+		typedef WorksheetElement BaseClass;
+		typedef XYSpectrumCurvePrivate Private;
+
+	protected:
+		XYSpectrumCurve(const QString& name, XYSpectrumCurvePrivate* dd);
+
+	private:
+		Q_DECLARE_PRIVATE(XYSpectrumCurve)
+		void init();
+
+	private slots:
+		void handleSourceDataChanged();
+
+	signals:
+		friend class XYSpectrumCurveSetXDataColumnCmd;
+		friend class XYSpectrumCurveSetYDataColumnCmd;
+		void xDataColumnChanged(const AbstractColumn*);
+		void yDataColumnChanged(const AbstractColumn*);
+
+		friend class XYSpectrumCurveSetSpectrumDataCmd;
+		void spectrumDataChanged(const XYSpectrumCurve::SpectrumData&);
+		void sourceDataChangedSinceLastSpectrum();
+};
+
+#endif
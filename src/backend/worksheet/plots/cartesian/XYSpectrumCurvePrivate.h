@@ -0,0 +1,68 @@
+/***************************************************************************
+    File                 : XYSpectrumCurvePrivate.h
+    Project              : LabPlot
+    Description          : Private members of XYSpectrumCurve
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef XYSPECTRUMCURVEPRIVATE_H
+#define XYSPECTRUMCURVEPRIVATE_H
+
+#include "backend/worksheet/plots/cartesian/XYCurvePrivate.h"
+#include "backend/worksheet/plots/cartesian/XYSpectrumCurve.h"
+
+#include <QDebug>
+
+class XYSpectrumCurve;
+class Column;
+struct nsl_fft_plan;
+
+class XYSpectrumCurvePrivate: public XYCurvePrivate {
+	public:
+		explicit XYSpectrumCurvePrivate(XYSpectrumCurve*);
+		~XYSpectrumCurvePrivate();
+		void recalculate();
+		bool sourceData(QVector<double>& ydata, double& xmin, double& xmax, QString& status) const;
+		bool analyze(const double* data, unsigned int segment, unsigned int step, unsigned int count, QVector<double>* sum, QVector<QVector<double> >* columns);
+
+		const AbstractColumn* xDataColumn; //<! column storing the values for the x-data to be analyzed
+		const AbstractColumn* yDataColumn; //<! column storing the values for the y-data to be analyzed
+		QString xDataColumnPath;
+		QString yDataColumnPath;
+
+		XYSpectrumCurve::SpectrumData spectrumData;
+		XYSpectrumCurve::SpectrumResult spectrumResult;
+
+		Column* xColumn; //<! column used internally for storing the x-values (frequencies) of the result curve
+		Column* yColumn; //<! column used internally for storing the y-values (densities) of the result curve
+		QVector<double>* xVector;
+		QVector<double>* yVector;
+
+		bool sourceDataChangedSinceLastSpectrum; //<! \c true if the data in the source columns (x, y) was changed, \c false otherwise
+		QVector<nsl_fft_plan*> fftPlans; //<! one FFT plan per thread, reused as long as the segment length doesn't change
+
+		XYSpectrumCurve* const q;
+};
+
+#endif
@@ -179,6 +179,7 @@ private:
 	QAction* addSmoothCurveAction;
 	QAction* addFitCurveAction;
 	QAction* addFourierFilterCurveAction;
+	QAction* addSpectrumCurveAction;
 	QAction* addHorizontalAxisAction;
 	QAction* addVerticalAxisAction;
 	QAction* addLegendAction;
@@ -203,6 +204,7 @@ private:
 	QAction* addSmoothAction;
 	QAction* addFitAction;
 	QAction* addFourierFilterAction;
+	QAction* addSpectrumAction;
 
 public slots:
 	void createContextMenu(QMenu*) const;
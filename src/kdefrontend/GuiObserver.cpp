@@ -57,6 +57,7 @@
 #include "kdefrontend/dockwidgets/XYFourierFilterCurveDock.h"
 #include "kdefrontend/dockwidgets/XYInterpolationCurveDock.h"
 #include "kdefrontend/dockwidgets/XYSmoothCurveDock.h"
+#include "kdefrontend/dockwidgets/XYSpectrumCurveDock.h"
 #include "kdefrontend/dockwidgets/CustomPointDock.h"
 #include "kdefrontend/dockwidgets/WorksheetDock.h"
 #include "kdefrontend/widgets/LabelWidget.h"
@@ -301,6 +302,23 @@ GuiObserver::GuiObserver(MainWin* mainWin) : m_lastCartesianPlot(0){
 	mainWindow->xyFourierFilterCurveDock->setCurves(list);
 
 	mainWindow->stackedWidget->setCurrentWidget(mainWindow->xyFourierFilterCurveDock);
+  }else if (className=="XYSpectrumCurve"){
+	mainWindow->m_propertiesDock->setWindowTitle(i18n("xy-spectrum-curve properties"));
+
+	if (!mainWindow->xySpectrumCurveDock){
+	  mainWindow->xySpectrumCurveDock = new XYSpectrumCurveDock(mainWindow->stackedWidget);
+	  mainWindow->xySpectrumCurveDock->setupGeneral();
+	  connect(mainWindow->xySpectrumCurveDock, SIGNAL(info(QString)), mainWindow->statusBar(), SLOT(showMessage(QString)));
+	  mainWindow->stackedWidget->addWidget(mainWindow->xySpectrumCurveDock);
+	}
+
+	QList<XYCurve*> list;
+	foreach(aspect, selectedAspects){
+	  list<<qobject_cast<XYCurve*>(aspect);
+	}
+	mainWindow->xySpectrumCurveDock->setCurves(list);
+
+	mainWindow->stackedWidget->setCurrentWidget(mainWindow->xySpectrumCurveDock);
   }else if (className=="XYInterpolationCurve"){
 	mainWindow->m_propertiesDock->setWindowTitle(i18n("xy-interpolation-curve properties"));
 
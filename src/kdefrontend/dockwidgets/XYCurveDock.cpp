@@ -124,6 +124,7 @@ XYCurveDock::XYCurveDock(QWidget *parent): QWidget(parent),
 	connect( ui.sbSymbolSize, SIGNAL(valueChanged(double)), this, SLOT(symbolsSizeChanged(double)) );
 	connect( ui.sbSymbolRotation, SIGNAL(valueChanged(int)), this, SLOT(symbolsRotationChanged(int)) );
 	connect( ui.sbSymbolOpacity, SIGNAL(valueChanged(int)), this, SLOT(symbolsOpacityChanged(int)) );
+	connect( ui.sbSymbolDensityThreshold, SIGNAL(valueChanged(int)), this, SLOT(symbolsDensityThresholdChanged(int)) );
 
 	connect( ui.cbSymbolFillingStyle, SIGNAL(currentIndexChanged(int)), this, SLOT(symbolsFillingStyleChanged(int)) );
 	connect( ui.kcbSymbolFillingColor, SIGNAL(changed(QColor)), this, SLOT(symbolsFillingColorChanged(QColor)) );
@@ -489,7 +490,7 @@ void XYCurveDock::setModel() {
 	QList<const char*>  list;
 	list<<"Folder"<<"Workbook"<<"Datapicker"<<"DatapickerCurve"<<"Spreadsheet"
 		<<"FileDataSource"<<"Column"<<"Worksheet"<<"CartesianPlot"
-		<<"XYInterpolationCurve"<<"XYFitCurve"<<"XYFourierFilterCurve";
+		<<"XYInterpolationCurve"<<"XYFitCurve"<<"XYFourierFilterCurve"<<"XYSpectrumCurve";
 
 	if (cbXColumn) {
 		cbXColumn->setTopLevelClasses(list);
@@ -623,6 +624,7 @@ void XYCurveDock::initTabs() {
 	connect(m_curve, SIGNAL(symbolsSizeChanged(qreal)), this, SLOT(curveSymbolsSizeChanged(qreal)));
 	connect(m_curve, SIGNAL(symbolsRotationAngleChanged(qreal)), this, SLOT(curveSymbolsRotationAngleChanged(qreal)));
 	connect(m_curve, SIGNAL(symbolsOpacityChanged(qreal)), this, SLOT(curveSymbolsOpacityChanged(qreal)));
+	connect(m_curve, SIGNAL(symbolsDensityThresholdChanged(int)), this, SLOT(curveSymbolsDensityThresholdChanged(int)));
 	connect(m_curve, SIGNAL(symbolsBrushChanged(QBrush)), this, SLOT(curveSymbolsBrushChanged(QBrush)));
 	connect(m_curve, SIGNAL(symbolsPenChanged(QPen)), this, SLOT(curveSymbolsPenChanged(QPen)));
 
@@ -1036,6 +1038,7 @@ void XYCurveDock::symbolsStyleChanged(int index){
 	ui.sbSymbolSize->setEnabled(false);
 	ui.sbSymbolRotation->setEnabled(false);
 	ui.sbSymbolOpacity->setEnabled(false);
+	ui.sbSymbolDensityThreshold->setEnabled(false);
 
 	ui.kcbSymbolFillingColor->setEnabled(false);
 	ui.cbSymbolFillingStyle->setEnabled(false);
@@ -1047,6 +1050,7 @@ void XYCurveDock::symbolsStyleChanged(int index){
 	ui.sbSymbolSize->setEnabled(true);
 	ui.sbSymbolRotation->setEnabled(true);
 	ui.sbSymbolOpacity->setEnabled(true);
+	ui.sbSymbolDensityThreshold->setEnabled(true);
 
 	//enable/disable the symbol filling options in the GUI depending on the currently selected symbol.
 	if (style!=Symbol::Line && style!=Symbol::Cross) {
@@ -1096,6 +1100,14 @@ void XYCurveDock::symbolsOpacityChanged(int value){
 		curve->setSymbolsOpacity(opacity);
 }
 
+void XYCurveDock::symbolsDensityThresholdChanged(int value){
+	if (m_initializing)
+		return;
+
+	foreach(XYCurve* curve, m_curvesList)
+		curve->setSymbolsDensityThreshold(value);
+}
+
 void XYCurveDock::symbolsFillingStyleChanged(int index){
   Qt::BrushStyle brushStyle = Qt::BrushStyle(index);
   ui.kcbSymbolFillingColor->setEnabled(!(brushStyle==Qt::NoBrush));
@@ -1828,6 +1840,11 @@ void XYCurveDock::curveSymbolsOpacityChanged(qreal opacity) {
 	ui.sbSymbolOpacity->setValue( round(opacity*100.0) );
 	m_initializing = false;
 }
+void XYCurveDock::curveSymbolsDensityThresholdChanged(int threshold) {
+	m_initializing = true;
+	ui.sbSymbolDensityThreshold->setValue(threshold);
+	m_initializing = false;
+}
 void XYCurveDock::curveSymbolsBrushChanged(QBrush brush) {
 	m_initializing = true;
   	ui.cbSymbolFillingStyle->setCurrentIndex((int) brush.style());
@@ -2030,6 +2047,7 @@ void XYCurveDock::load() {
   	ui.sbSymbolSize->setValue( Worksheet::convertFromSceneUnits(m_curve->symbolsSize(), Worksheet::Point) );
 	ui.sbSymbolRotation->setValue( m_curve->symbolsRotationAngle() );
 	ui.sbSymbolOpacity->setValue( round(m_curve->symbolsOpacity()*100.0) );
+	ui.sbSymbolDensityThreshold->setValue( m_curve->symbolsDensityThreshold() );
   	ui.cbSymbolFillingStyle->setCurrentIndex( (int) m_curve->symbolsBrush().style() );
   	ui.kcbSymbolFillingColor->setColor(  m_curve->symbolsBrush().color() );
   	ui.cbSymbolBorderStyle->setCurrentIndex( (int) m_curve->symbolsPen().style() );
@@ -2129,6 +2147,7 @@ void XYCurveDock::loadConfig(KConfig& config) {
   	ui.sbSymbolSize->setValue( Worksheet::convertFromSceneUnits(group.readEntry("SymbolSize", m_curve->symbolsSize()), Worksheet::Point) );
 	ui.sbSymbolRotation->setValue( group.readEntry("SymbolRotation", m_curve->symbolsRotationAngle()) );
 	ui.sbSymbolOpacity->setValue( round(group.readEntry("SymbolOpacity", m_curve->symbolsOpacity())*100.0) );
+	ui.sbSymbolDensityThreshold->setValue( group.readEntry("SymbolDensityThreshold", m_curve->symbolsDensityThreshold()) );
   	ui.cbSymbolFillingStyle->setCurrentIndex( group.readEntry("SymbolFillingStyle", (int) m_curve->symbolsBrush().style()) );
   	ui.kcbSymbolFillingColor->setColor(  group.readEntry("SymbolFillingColor", m_curve->symbolsBrush().color()) );
   	ui.cbSymbolBorderStyle->setCurrentIndex( group.readEntry("SymbolBorderStyle", (int) m_curve->symbolsPen().style()) );
@@ -2205,6 +2224,7 @@ void XYCurveDock::saveConfigAsTemplate(KConfig& config) {
 	group.writeEntry("SymbolSize", Worksheet::convertToSceneUnits(ui.sbSymbolSize->value(),Worksheet::Point));
 	group.writeEntry("SymbolRotation", ui.sbSymbolRotation->value());
 	group.writeEntry("SymbolOpacity", ui.sbSymbolOpacity->value()/100 );
+	group.writeEntry("SymbolDensityThreshold", ui.sbSymbolDensityThreshold->value());
 	group.writeEntry("SymbolFillingStyle", ui.cbSymbolFillingStyle->currentIndex());
 	group.writeEntry("SymbolFillingColor", ui.kcbSymbolFillingColor->color());
 	group.writeEntry("SymbolBorderStyle", ui.cbSymbolBorderStyle->currentIndex());
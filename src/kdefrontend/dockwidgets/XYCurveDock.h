@@ -116,6 +116,7 @@ private slots:
 	void symbolsSizeChanged(double);
 	void symbolsRotationChanged(int);
 	void symbolsOpacityChanged(int);
+	void symbolsDensityThresholdChanged(int);
 	void symbolsFillingStyleChanged(int);
 	void symbolsFillingColorChanged(const QColor&);
 	void symbolsBorderStyleChanged(int);
@@ -182,6 +183,7 @@ private slots:
 	void curveSymbolsSizeChanged(qreal);
 	void curveSymbolsRotationAngleChanged(qreal);
 	void curveSymbolsOpacityChanged(qreal);
+	void curveSymbolsDensityThresholdChanged(int);
 	void curveSymbolsBrushChanged(QBrush);
 	void curveSymbolsPenChanged(const QPen&);
 
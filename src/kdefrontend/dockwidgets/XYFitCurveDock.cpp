@@ -38,6 +38,7 @@
 #include <QMenu>
 #include <QWidgetAction>
 #include <QDebug>
+#include <cfloat>
 
 /*!
   \class XYFitCurveDock
@@ -446,6 +447,11 @@ void XYFitCurveDock::updateModelEquation() {
 		m_fitData.paramStartValues.resize(m_fitData.paramNames.size());
 		for (int i=0; i<m_fitData.paramStartValues.size(); ++i)
 			m_fitData.paramStartValues[i] = 1.0;
+
+		//no limits, all parameters free
+		m_fitData.paramFixed.fill(false, m_fitData.paramNames.size());
+		m_fitData.paramLowerLimits.fill(-DBL_MAX, m_fitData.paramNames.size());
+		m_fitData.paramUpperLimits.fill(DBL_MAX, m_fitData.paramNames.size());
 	}
 
 	uiGeneralTab.teEquation->setVariables(vars);
@@ -604,6 +610,32 @@ void XYFitCurveDock::showFitResult() {
 
 	str += i18n("coefficient of determination (R²):") + " " + QString::number(fitResult.rsquared) + "<br>";
 	str += i18n("adj. coefficient of determination (R²):") + " " + QString::number(fitResult.rsquaredAdj) + "<br>";
+
+	str += "<br><b>" + i18n("Diagnostics:") + "</b><br>";
+	QString convergence;
+	switch (fitResult.convergence) {
+	case XYFitCurve::ConvergenceStepSize:
+		convergence = i18n("step size below tolerance");
+		break;
+	case XYFitCurve::ConvergenceMaxIterations:
+		convergence = i18n("maximal number of iterations reached");
+		break;
+	case XYFitCurve::ConvergenceNoProgress:
+		convergence = i18n("no further progress possible");
+		break;
+	case XYFitCurve::ConvergenceError:
+		convergence = i18n("error");
+		break;
+	case XYFitCurve::ConvergenceNone:
+		convergence = i18n("not available");
+		break;
+	}
+	str += i18n("convergence:") + " " + convergence + "<br>";
+	str += i18n("function evaluations: %1 (%2 ms)", fitResult.fEvaluations, QString::number(fitResult.fTime, 'f', 1)) + "<br>";
+	str += i18n("Jacobian evaluations: %1 (%2 ms)", fitResult.dfEvaluations, QString::number(fitResult.dfTime, 'f', 1)) + "<br>";
+	str += i18n("preparation time: %1 ms", QString::number(fitResult.prepareTime, 'f', 1)) + "<br>";
+	str += i18n("solver time: %1 ms", QString::number(fitResult.solverTime, 'f', 1)) + "<br>";
+	str += i18n("condition number of J<sup>T</sup>J:") + " " + QString::number(fitResult.conditionNumber, 'g', 3) + "<br>";
 // 	str += "<br><br>";
 //
 // 	QStringList iterations = fitResult.solverOutput.split(';');
@@ -112,6 +112,8 @@ void XYFourierFilterCurveDock::setupGeneral() {
 	connect( uiGeneralTab.sbCutoff2, SIGNAL(valueChanged(double)), this, SLOT(enableRecalculate()) );
 	connect( uiGeneralTab.cbUnit, SIGNAL(currentIndexChanged(int)), this, SLOT(unitChanged(int)) );
 	connect( uiGeneralTab.cbUnit2, SIGNAL(currentIndexChanged(int)), this, SLOT(unit2Changed(int)) );
+	connect( uiGeneralTab.chkZeroPadding, SIGNAL(clicked(bool)), this, SLOT(zeroPaddingChanged(bool)) );
+	connect( uiGeneralTab.chkStreaming, SIGNAL(clicked(bool)), this, SLOT(streamingChanged(bool)) );
 
 //	connect( uiGeneralTab.pbOptions, SIGNAL(clicked()), this, SLOT(showOptions()) );
 	connect( uiGeneralTab.pbRecalculate, SIGNAL(clicked()), this, SLOT(recalculateClicked()) );
@@ -156,6 +158,9 @@ void XYFourierFilterCurveDock::initGeneralTab() {
 	this->unit2Changed(m_filterData.unit2);
 	// after unit has set
 	uiGeneralTab.sbCutoff2->setValue(m_filterData.cutoff2);
+	uiGeneralTab.chkZeroPadding->setChecked(m_filterData.zeroPadding);
+	uiGeneralTab.chkStreaming->setChecked(m_filterData.streaming);
+	uiGeneralTab.chkZeroPadding->setEnabled(!m_filterData.streaming);
 	this->showFilterResult();
 
 	//enable the "recalculate"-button if the source data was changed since the last filter
@@ -387,6 +392,20 @@ void XYFourierFilterCurveDock::unit2Changed(int index) {
 	uiGeneralTab.pbRecalculate->setEnabled(true);
 }
 
+void XYFourierFilterCurveDock::zeroPaddingChanged(bool checked) {
+	m_filterData.zeroPadding = checked;
+
+	uiGeneralTab.pbRecalculate->setEnabled(true);
+}
+
+void XYFourierFilterCurveDock::streamingChanged(bool checked) {
+	m_filterData.streaming = checked;
+	//no transform of the whole data, no padding
+	uiGeneralTab.chkZeroPadding->setEnabled(!checked);
+
+	uiGeneralTab.pbRecalculate->setEnabled(true);
+}
+
 void XYFourierFilterCurveDock::recalculateClicked() {
 	m_filterData.cutoff = uiGeneralTab.sbCutoff->value();
 	m_filterData.cutoff2 = uiGeneralTab.sbCutoff2->value();
@@ -69,6 +69,8 @@ private slots:
 	void orderChanged(int);
 	void unitChanged(int);
 	void unit2Changed(int);
+	void zeroPaddingChanged(bool);
+	void streamingChanged(bool);
 
 //	void showOptions();
 	void recalculateClicked();
@@ -0,0 +1,392 @@
+/***************************************************************************
+    File             : XYSpectrumCurveDock.cpp
+    Project          : LabPlot
+    --------------------------------------------------------------------
+    Copyright        : (C) 2026 agent (agent@local)
+    Description      : widget for editing properties of power spectrum curves
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "XYSpectrumCurveDock.h"
+#include "backend/core/AspectTreeModel.h"
+#include "backend/core/Folder.h"
+#include "backend/core/Project.h"
+#include "backend/matrix/Matrix.h"
+#include "backend/worksheet/plots/cartesian/XYSpectrumCurve.h"
+#include "commonfrontend/widgets/TreeViewComboBox.h"
+
+#include <QDebug>
+#include <KMessageBox>
+
+/*!
+  \class XYSpectrumCurveDock
+ \brief  Provides a widget for editing the properties of the XYSpectrumCurves
+		(2D-curves defined by a power spectrum) currently selected in
+		the project explorer.
+
+  If more then one curves are set, the properties of the first column are shown.
+  The changes of the properties are applied to all curves.
+  The exclusions are the name, the comment and the datasets (columns) of
+  the curves  - these properties can only be changed if there is only one single curve.
+
+  \ingroup kdefrontend
+*/
+
+XYSpectrumCurveDock::XYSpectrumCurveDock(QWidget *parent):
+	XYCurveDock(parent), cbXDataColumn(0), cbYDataColumn(0), m_spectrumCurve(0) {
+
+	//remove the tab "Error bars"
+	ui.tabWidget->removeTab(5);
+}
+
+/*!
+ * 	// Tab "General"
+ */
+void XYSpectrumCurveDock::setupGeneral() {
+	QWidget* generalTab = new QWidget(ui.tabGeneral);
+	uiGeneralTab.setupUi(generalTab);
+
+	QGridLayout* gridLayout = dynamic_cast<QGridLayout*>(generalTab->layout());
+	if (gridLayout) {
+		gridLayout->setContentsMargins(2,2,2,2);
+		gridLayout->setHorizontalSpacing(2);
+		gridLayout->setVerticalSpacing(2);
+	}
+
+	cbXDataColumn = new TreeViewComboBox(generalTab);
+	gridLayout->addWidget(cbXDataColumn, 4, 2, 1, 2);
+	cbYDataColumn = new TreeViewComboBox(generalTab);
+	gridLayout->addWidget(cbYDataColumn, 5, 2, 1, 2);
+
+	uiGeneralTab.cbMethod->addItem(i18n("Periodogram"));
+	uiGeneralTab.cbMethod->addItem(i18n("Welch (averaged segments)"));
+
+	uiGeneralTab.cbWindow->addItem(i18n("Rectangular"));
+	uiGeneralTab.cbWindow->addItem(i18n("Triangular"));
+	uiGeneralTab.cbWindow->addItem(i18n("Welch"));
+	uiGeneralTab.cbWindow->addItem(i18n("Hann"));
+	uiGeneralTab.cbWindow->addItem(i18n("Hamming"));
+	uiGeneralTab.cbWindow->addItem(i18n("Blackman"));
+	uiGeneralTab.pbRecalculate->setIcon(KIcon("run-build"));
+
+	QHBoxLayout* layout = new QHBoxLayout(ui.tabGeneral);
+	layout->setMargin(0);
+	layout->addWidget(generalTab);
+
+	//Slots
+	connect( uiGeneralTab.leName, SIGNAL(returnPressed()), this, SLOT(nameChanged()) );
+	connect( uiGeneralTab.leComment, SIGNAL(returnPressed()), this, SLOT(commentChanged()) );
+	connect( uiGeneralTab.chkVisible, SIGNAL(clicked(bool)), this, SLOT(visibilityChanged(bool)) );
+
+	connect( uiGeneralTab.cbMethod, SIGNAL(currentIndexChanged(int)), this, SLOT(methodChanged(int)) );
+	connect( uiGeneralTab.cbWindow, SIGNAL(currentIndexChanged(int)), this, SLOT(windowChanged(int)) );
+	connect( uiGeneralTab.sbSegmentLength, SIGNAL(valueChanged(int)), this, SLOT(segmentLengthChanged(int)) );
+	connect( uiGeneralTab.sbOverlap, SIGNAL(valueChanged(int)), this, SLOT(overlapChanged(int)) );
+	connect( uiGeneralTab.chkDecibel, SIGNAL(clicked(bool)), this, SLOT(decibelChanged(bool)) );
+
+	connect( uiGeneralTab.pbRecalculate, SIGNAL(clicked()), this, SLOT(recalculateClicked()) );
+	connect( uiGeneralTab.pbSpectrogram, SIGNAL(clicked()), this, SLOT(spectrogramClicked()) );
+}
+
+void XYSpectrumCurveDock::initGeneralTab() {
+	//if there are more then one curve in the list, disable the tab "general"
+	if (m_curvesList.size()==1){
+		uiGeneralTab.lName->setEnabled(true);
+		uiGeneralTab.leName->setEnabled(true);
+		uiGeneralTab.lComment->setEnabled(true);
+		uiGeneralTab.leComment->setEnabled(true);
+
+		uiGeneralTab.leName->setText(m_curve->name());
+		uiGeneralTab.leComment->setText(m_curve->comment());
+	}else {
+		uiGeneralTab.lName->setEnabled(false);
+		uiGeneralTab.leName->setEnabled(false);
+		uiGeneralTab.lComment->setEnabled(false);
+		uiGeneralTab.leComment->setEnabled(false);
+
+		uiGeneralTab.leName->setText("");
+		uiGeneralTab.leComment->setText("");
+	}
+
+	//show the properties of the first curve
+	m_spectrumCurve = dynamic_cast<XYSpectrumCurve*>(m_curve);
+	Q_ASSERT(m_spectrumCurve);
+	XYCurveDock::setModelIndexFromColumn(cbXDataColumn, m_spectrumCurve->xDataColumn());
+	XYCurveDock::setModelIndexFromColumn(cbYDataColumn, m_spectrumCurve->yDataColumn());
+
+	uiGeneralTab.cbMethod->setCurrentIndex(m_spectrumData.method);
+	this->methodChanged(m_spectrumData.method);
+	uiGeneralTab.cbWindow->setCurrentIndex(m_spectrumData.window);
+	//the segment length limits the overlap
+	const unsigned int overlap = m_spectrumData.overlap;
+	uiGeneralTab.sbSegmentLength->setValue(m_spectrumData.segmentLength);
+	uiGeneralTab.sbOverlap->setValue(overlap);
+	uiGeneralTab.chkDecibel->setChecked(m_spectrumData.decibel);
+	this->showSpectrumResult();
+
+	//enable the "recalculate"-button if the source data was changed since the last spectrum
+	uiGeneralTab.pbRecalculate->setEnabled(m_spectrumCurve->isSourceDataChangedSinceLastSpectrum());
+	uiGeneralTab.pbSpectrogram->setEnabled(m_spectrumCurve->xDataColumn() && m_spectrumCurve->yDataColumn());
+
+	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+
+	//Slots
+	connect(m_spectrumCurve, SIGNAL(aspectDescriptionChanged(const AbstractAspect*)), this, SLOT(curveDescriptionChanged(const AbstractAspect*)));
+	connect(m_spectrumCurve, SIGNAL(xDataColumnChanged(const AbstractColumn*)), this, SLOT(curveXDataColumnChanged(const AbstractColumn*)));
+	connect(m_spectrumCurve, SIGNAL(yDataColumnChanged(const AbstractColumn*)), this, SLOT(curveYDataColumnChanged(const AbstractColumn*)));
+	connect(m_spectrumCurve, SIGNAL(spectrumDataChanged(XYSpectrumCurve::SpectrumData)), this, SLOT(curveSpectrumDataChanged(XYSpectrumCurve::SpectrumData)));
+	connect(m_spectrumCurve, SIGNAL(sourceDataChangedSinceLastSpectrum()), this, SLOT(enableRecalculate()));
+}
+
+void XYSpectrumCurveDock::setModel() {
+	QList<const char*>  list;
+	list<<"Folder"<<"Workbook"<<"Spreadsheet"<<"FileDataSource"<<"Column"<<"Datapicker";
+	cbXDataColumn->setTopLevelClasses(list);
+	cbYDataColumn->setTopLevelClasses(list);
+
+ 	list.clear();
+	list<<"Column";
+	cbXDataColumn->setSelectableClasses(list);
+	cbYDataColumn->setSelectableClasses(list);
+
+	cbXDataColumn->setModel(m_aspectTreeModel);
+	cbYDataColumn->setModel(m_aspectTreeModel);
+
+	connect( cbXDataColumn, SIGNAL(currentModelIndexChanged(QModelIndex)), this, SLOT(xDataColumnChanged(QModelIndex)) );
+	connect( cbYDataColumn, SIGNAL(currentModelIndexChanged(QModelIndex)), this, SLOT(yDataColumnChanged(QModelIndex)) );
+	XYCurveDock::setModel();
+}
+
+/*!
+  sets the curves. The properties of the curves in the list \c list can be edited in this widget.
+*/
+void XYSpectrumCurveDock::setCurves(QList<XYCurve*> list) {
+	m_initializing=true;
+	m_curvesList=list;
+	m_curve=list.first();
+	m_spectrumCurve = dynamic_cast<XYSpectrumCurve*>(m_curve);
+	Q_ASSERT(m_spectrumCurve);
+	m_aspectTreeModel = new AspectTreeModel(m_curve->project());
+	this->setModel();
+	m_spectrumData = m_spectrumCurve->spectrumData();
+	initGeneralTab();
+	initTabs();
+	m_initializing=false;
+}
+
+//*************************************************************
+//**** SLOTs for changes triggered in XYSpectrumCurveDock *****
+//*************************************************************
+void XYSpectrumCurveDock::nameChanged(){
+	if (m_initializing)
+		return;
+
+	m_curve->setName(uiGeneralTab.leName->text());
+}
+
+void XYSpectrumCurveDock::commentChanged(){
+	if (m_initializing)
+		return;
+
+	m_curve->setComment(uiGeneralTab.leComment->text());
+}
+
+void XYSpectrumCurveDock::xDataColumnChanged(const QModelIndex& index) {
+	if (m_initializing)
+		return;
+
+	AbstractAspect* aspect = static_cast<AbstractAspect*>(index.internalPointer());
+	AbstractColumn* column = 0;
+	if (aspect) {
+		column = dynamic_cast<AbstractColumn*>(aspect);
+		Q_ASSERT(column);
+	}
+
+	foreach(XYCurve* curve, m_curvesList)
+		dynamic_cast<XYSpectrumCurve*>(curve)->setXDataColumn(column);
+}
+
+void XYSpectrumCurveDock::yDataColumnChanged(const QModelIndex& index) {
+	if (m_initializing)
+		return;
+
+	AbstractAspect* aspect = static_cast<AbstractAspect*>(index.internalPointer());
+	AbstractColumn* column = 0;
+	if (aspect) {
+		column = dynamic_cast<AbstractColumn*>(aspect);
+		Q_ASSERT(column);
+	}
+
+	foreach(XYCurve* curve, m_curvesList)
+		dynamic_cast<XYSpectrumCurve*>(curve)->setYDataColumn(column);
+}
+
+void XYSpectrumCurveDock::methodChanged(int index) {
+	m_spectrumData.method = (XYSpectrumCurve::SpectrumMethod)index;
+
+	//the periodogram uses all data as one segment
+	const bool welch = (m_spectrumData.method == XYSpectrumCurve::Welch);
+	uiGeneralTab.lSegmentLength->setEnabled(welch);
+	uiGeneralTab.sbSegmentLength->setEnabled(welch);
+	uiGeneralTab.lOverlap->setEnabled(welch);
+	uiGeneralTab.sbOverlap->setEnabled(welch);
+
+	uiGeneralTab.pbRecalculate->setEnabled(true);
+}
+
+void XYSpectrumCurveDock::windowChanged(int index) {
+	m_spectrumData.window = (XYSpectrumCurve::WindowType)index;
+
+	uiGeneralTab.pbRecalculate->setEnabled(true);
+}
+
+void XYSpectrumCurveDock::segmentLengthChanged(int value) {
+	m_spectrumData.segmentLength = value;
+	//the segments must not overlap completely
+	uiGeneralTab.sbOverlap->setMaximum(value - 1);
+
+	uiGeneralTab.pbRecalculate->setEnabled(true);
+}
+
+void XYSpectrumCurveDock::overlapChanged(int value) {
+	m_spectrumData.overlap = value;
+
+	uiGeneralTab.pbRecalculate->setEnabled(true);
+}
+
+void XYSpectrumCurveDock::decibelChanged(bool checked) {
+	m_spectrumData.decibel = checked;
+
+	uiGeneralTab.pbRecalculate->setEnabled(true);
+}
+
+void XYSpectrumCurveDock::recalculateClicked() {
+	QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+	foreach(XYCurve* curve, m_curvesList)
+		dynamic_cast<XYSpectrumCurve*>(curve)->setSpectrumData(m_spectrumData);
+
+	uiGeneralTab.pbRecalculate->setEnabled(false);
+	QApplication::restoreOverrideCursor();
+}
+
+/*!
+ * calculates the spectrogram of the first curve with the current segment options
+ * and adds it as a new matrix to the folder of the curve
+ */
+void XYSpectrumCurveDock::spectrogramClicked() {
+	//apply changed options first
+	if (uiGeneralTab.pbRecalculate->isEnabled())
+		recalculateClicked();
+
+	QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+	Matrix* matrix = m_spectrumCurve->createSpectrogram();
+	if (matrix)
+		m_spectrumCurve->folder()->addChild(matrix);
+	QApplication::restoreOverrideCursor();
+
+	if (!matrix)
+		KMessageBox::sorry(this, i18n("The spectrogram can't be calculated. The segment length must be between 2 and the number of data points and larger than the overlap."),
+			                   i18n("Spectrogram") );
+}
+
+void XYSpectrumCurveDock::enableRecalculate() const {
+	if (m_initializing)
+		return;
+
+	//no spectrum possible without the x- and y-data
+	AbstractAspect* aspectX = static_cast<AbstractAspect*>(cbXDataColumn->currentModelIndex().internalPointer());
+	AbstractAspect* aspectY = static_cast<AbstractAspect*>(cbYDataColumn->currentModelIndex().internalPointer());
+	bool data = (aspectX!=0 && aspectY!=0);
+
+	uiGeneralTab.pbRecalculate->setEnabled(data);
+	uiGeneralTab.pbSpectrogram->setEnabled(data);
+}
+
+/*!
+ * show the result and details of the spectrum
+ */
+void XYSpectrumCurveDock::showSpectrumResult() {
+	const XYSpectrumCurve::SpectrumResult& spectrumResult = m_spectrumCurve->spectrumResult();
+	if (!spectrumResult.available) {
+		uiGeneralTab.teResult->clear();
+		return;
+	}
+
+	QString str = i18n("status:") + " " + spectrumResult.status + "<br>";
+
+	if (!spectrumResult.valid) {
+		uiGeneralTab.teResult->setText(str);
+		return; //result is not valid, there was an error which is shown in the status-string, nothing to show more.
+	}
+
+	if (spectrumResult.elapsedTime>1000)
+		str += i18n("calculation time: %1 s").arg(QString::number(spectrumResult.elapsedTime/1000)) + "<br>";
+	else
+		str += i18n("calculation time: %1 ms").arg(QString::number(spectrumResult.elapsedTime)) + "<br>";
+
+ 	str += "<br><br>";
+
+	uiGeneralTab.teResult->setText(str);
+}
+
+//*************************************************************
+//*********** SLOTs for changes triggered in XYCurve **********
+//*************************************************************
+//General-Tab
+void XYSpectrumCurveDock::curveDescriptionChanged(const AbstractAspect* aspect) {
+	if (m_curve != aspect)
+		return;
+
+	m_initializing = true;
+	if (aspect->name() != uiGeneralTab.leName->text()) {
+		uiGeneralTab.leName->setText(aspect->name());
+	} else if (aspect->comment() != uiGeneralTab.leComment->text()) {
+		uiGeneralTab.leComment->setText(aspect->comment());
+	}
+	m_initializing = false;
+}
+
+void XYSpectrumCurveDock::curveXDataColumnChanged(const AbstractColumn* column) {
+	m_initializing = true;
+	XYCurveDock::setModelIndexFromColumn(cbXDataColumn, column);
+	m_initializing = false;
+}
+
+void XYSpectrumCurveDock::curveYDataColumnChanged(const AbstractColumn* column) {
+	m_initializing = true;
+	XYCurveDock::setModelIndexFromColumn(cbYDataColumn, column);
+	m_initializing = false;
+}
+
+void XYSpectrumCurveDock::curveSpectrumDataChanged(const XYSpectrumCurve::SpectrumData& data) {
+	m_initializing = true;
+	m_spectrumData = data;
+	uiGeneralTab.cbMethod->setCurrentIndex(m_spectrumData.method);
+	this->methodChanged(m_spectrumData.method);
+
+	this->showSpectrumResult();
+	m_initializing = false;
+}
+
+void XYSpectrumCurveDock::dataChanged() {
+	this->enableRecalculate();
+}
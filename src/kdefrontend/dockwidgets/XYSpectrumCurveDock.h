@@ -0,0 +1,88 @@
+/***************************************************************************
+    File             : XYSpectrumCurveDock.h
+    Project          : LabPlot
+    --------------------------------------------------------------------
+    Copyright        : (C) 2026 agent (agent@local)
+    Description      : widget for editing properties of power spectrum curves
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef XYSPECTRUMCURVEDOCK_H
+#define XYSPECTRUMCURVEDOCK_H
+
+#include "kdefrontend/dockwidgets/XYCurveDock.h"
+#include "backend/worksheet/plots/cartesian/XYSpectrumCurve.h"
+#include "ui_xyspectrumcurvedockgeneraltab.h"
+
+class TreeViewComboBox;
+
+class XYSpectrumCurveDock: public XYCurveDock {
+	Q_OBJECT
+
+public:
+	explicit XYSpectrumCurveDock(QWidget *parent);
+	void setCurves(QList<XYCurve*>);
+	virtual void setupGeneral();
+
+private:
+	virtual void initGeneralTab();
+	void showSpectrumResult();
+
+	Ui::XYSpectrumCurveDockGeneralTab uiGeneralTab;
+	TreeViewComboBox* cbXDataColumn;
+	TreeViewComboBox* cbYDataColumn;
+
+	XYSpectrumCurve* m_spectrumCurve;
+	XYSpectrumCurve::SpectrumData m_spectrumData;
+
+protected:
+	virtual void setModel();
+
+private slots:
+	//SLOTs for changes triggered in XYSpectrumCurveDock
+	//general tab
+	void nameChanged();
+	void commentChanged();
+	void xDataColumnChanged(const QModelIndex&);
+	void yDataColumnChanged(const QModelIndex&);
+	void methodChanged(int);
+	void windowChanged(int);
+	void segmentLengthChanged(int);
+	void overlapChanged(int);
+	void decibelChanged(bool);
+
+	void recalculateClicked();
+	void spectrogramClicked();
+
+	void enableRecalculate() const;
+
+	//SLOTs for changes triggered in XYCurve
+	//General-Tab
+	void curveDescriptionChanged(const AbstractAspect*);
+	void curveXDataColumnChanged(const AbstractColumn*);
+	void curveYDataColumnChanged(const AbstractColumn*);
+	void curveSpectrumDataChanged(const XYSpectrumCurve::SpectrumData&);
+	void dataChanged();
+
+};
+
+#endif
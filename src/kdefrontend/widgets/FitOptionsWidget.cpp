@@ -27,6 +27,8 @@
  ***************************************************************************/
 #include "FitOptionsWidget.h"
 
+#include <climits>
+
 /*!
 	\class FitOptionsWidget
 	\brief Widget for editing advanced fit options.
@@ -38,32 +40,57 @@ FitOptionsWidget::FitOptionsWidget(QWidget *parent, XYFitCurve::FitData* fitData
 	ui.pbApply->setIcon(KIcon("dialog-ok-apply"));
 	ui.pbCancel->setIcon(KIcon("dialog-cancel"));
 
-	//TODO: show "robust" option when robust fitting is possible
-// 	ui.cbRobust->addItem(i18n("on"));
-// 	ui.cbRobust->addItem(i18n("off"));
-	ui.lRobust->setVisible(false);
-	ui.cbRobust->setVisible(false);
+	ui.cbRobust->addItem(i18n("off"));
+	ui.cbRobust->addItem(i18n("Huber"));
+	ui.cbRobust->addItem(i18n("Cauchy"));
+	ui.cbRobust->addItem(i18n("Bisquare"));
 
 	ui.leEps->setValidator( new QDoubleValidator(ui.leEps) );
+	ui.leOutlierThreshold->setValidator( new QDoubleValidator(0, 1e6, 3, ui.leOutlierThreshold) );
 	ui.leMaxIterations->setValidator( new QIntValidator(ui.leMaxIterations) );
 	ui.leFittedPoints->setValidator( new QIntValidator(ui.leFittedPoints) );
+	ui.leChunkSize->setValidator( new QIntValidator(1, INT_MAX, ui.leChunkSize) );
+	ui.lePrefitPoints->setValidator( new QIntValidator(0, INT_MAX, ui.lePrefitPoints) );
 
+	ui.cbRobust->setCurrentIndex(m_fitData->robustType);
+	ui.chkMarkOutliers->setChecked(m_fitData->markOutliers);
+	ui.leOutlierThreshold->setText(QString::number(m_fitData->outlierThreshold));
+	robustTypeChanged(m_fitData->robustType);
 	ui.leEps->setText(QString::number(m_fitData->eps));
 	ui.leMaxIterations->setText(QString::number(m_fitData->maxIterations));
 	ui.leFittedPoints->setText(QString::number(m_fitData->fittedPoints));
+	ui.chkLargeDataMode->setChecked(m_fitData->largeDataMode);
+	ui.leChunkSize->setText(QString::number(m_fitData->chunkSize));
+	ui.leChunkSize->setEnabled(m_fitData->largeDataMode);
+	ui.lePrefitPoints->setText(QString::number(m_fitData->prefitPoints));
 
 	//SLOTS
+	connect( ui.cbRobust, SIGNAL(currentIndexChanged(int)), this, SLOT(robustTypeChanged(int)) ) ;
+	connect( ui.cbRobust, SIGNAL(currentIndexChanged(int)), this, SLOT(changed()) ) ;
+	connect( ui.chkMarkOutliers, SIGNAL(toggled(bool)), this, SLOT(changed()) ) ;
+	connect( ui.chkMarkOutliers, SIGNAL(toggled(bool)), ui.leOutlierThreshold, SLOT(setEnabled(bool)) ) ;
+	connect( ui.leOutlierThreshold, SIGNAL(textChanged(QString)), this, SLOT(changed()) ) ;
 	connect( ui.leEps, SIGNAL(textChanged(QString)), this, SLOT(changed()) ) ;
 	connect( ui.leMaxIterations, SIGNAL(textChanged(QString)), this, SLOT(changed()) ) ;
 	connect( ui.leFittedPoints, SIGNAL(textChanged(QString)), this, SLOT(changed()) ) ;
+	connect( ui.chkLargeDataMode, SIGNAL(toggled(bool)), this, SLOT(changed()) ) ;
+	connect( ui.chkLargeDataMode, SIGNAL(toggled(bool)), ui.leChunkSize, SLOT(setEnabled(bool)) ) ;
+	connect( ui.leChunkSize, SIGNAL(textChanged(QString)), this, SLOT(changed()) ) ;
+	connect( ui.lePrefitPoints, SIGNAL(textChanged(QString)), this, SLOT(changed()) ) ;
 	connect( ui.pbApply, SIGNAL(clicked()), this, SLOT(applyClicked()) );
 	connect( ui.pbCancel, SIGNAL(clicked()), this, SIGNAL(finished()) );
 }
 
 void FitOptionsWidget::applyClicked() {
+	m_fitData->robustType = (XYFitCurve::RobustType)ui.cbRobust->currentIndex();
+	m_fitData->markOutliers = ui.chkMarkOutliers->isChecked();
+	m_fitData->outlierThreshold = ui.leOutlierThreshold->text().toDouble();
 	m_fitData->maxIterations = ui.leMaxIterations->text().toFloat();
 	m_fitData->eps = ui.leEps->text().toFloat();
 	m_fitData->fittedPoints = ui.leFittedPoints->text().toInt();
+	m_fitData->largeDataMode = ui.chkLargeDataMode->isChecked();
+	m_fitData->chunkSize = ui.leChunkSize->text().toInt();
+	m_fitData->prefitPoints = ui.lePrefitPoints->text().toInt();
 
 	if (m_changed)
 		emit(optionsChanged());
@@ -71,6 +98,16 @@ void FitOptionsWidget::applyClicked() {
 	emit(finished());
 }
 
+/*!
+ * the outliers can only be marked for robust fits
+ */
+void FitOptionsWidget::robustTypeChanged(int index) {
+	const bool robust = (index != XYFitCurve::RobustNone);
+	ui.lMarkOutliers->setEnabled(robust);
+	ui.chkMarkOutliers->setEnabled(robust);
+	ui.leOutlierThreshold->setEnabled(robust && ui.chkMarkOutliers->isChecked());
+}
+
 void FitOptionsWidget::changed() {
 	m_changed = true;
 }
@@ -48,6 +48,7 @@ signals:
 
 private slots:
 	void applyClicked();
+	void robustTypeChanged(int);
 	void changed();
 };
 
@@ -27,12 +27,14 @@
  ***************************************************************************/
 #include "FitParametersWidget.h"
 #include <QKeyEvent>
+#include <cfloat>
 
 /*!
 	\class FitParametersWidget
 	\brief Widget for editing fit parameters. For predefined models the number of parameters,
 	their names and default values are given - the user can change the start values.
 	For custom models the user has to define here the parameter names and their start values.
+	For all models, parameters can be fixed to their start values or restricted to a range given by lower and upper limits.
 
 	\ingroup kdefrontend
  */
@@ -41,7 +43,7 @@ FitParametersWidget::FitParametersWidget(QWidget* parent, XYFitCurve::FitData* d
 	ui.pbApply->setIcon(KIcon("dialog-ok-apply"));
 	ui.pbCancel->setIcon(KIcon("dialog-cancel"));
 
-	ui.tableWidget->setColumnCount(2);
+	ui.tableWidget->setColumnCount(5);
 
 	QTableWidgetItem* headerItem = new QTableWidgetItem();
 	headerItem->setText(i18n("Name"));
@@ -51,8 +53,32 @@ FitParametersWidget::FitParametersWidget(QWidget* parent, XYFitCurve::FitData* d
 	headerItem->setText(i18n("Start value"));
 	ui.tableWidget->setHorizontalHeaderItem(1, headerItem);
 
+	headerItem = new QTableWidgetItem();
+	headerItem->setText(i18n("Fixed"));
+	ui.tableWidget->setHorizontalHeaderItem(2, headerItem);
+
+	headerItem = new QTableWidgetItem();
+	headerItem->setText(i18n("Lower limit"));
+	ui.tableWidget->setHorizontalHeaderItem(3, headerItem);
+
+	headerItem = new QTableWidgetItem();
+	headerItem->setText(i18n("Upper limit"));
+	ui.tableWidget->setHorizontalHeaderItem(4, headerItem);
+
 	ui.tableWidget->horizontalHeader()->setResizeMode(0, QHeaderView::ResizeToContents);
 	ui.tableWidget->horizontalHeader()->setResizeMode(1, QHeaderView::Stretch);
+	ui.tableWidget->horizontalHeader()->setResizeMode(2, QHeaderView::ResizeToContents);
+	ui.tableWidget->horizontalHeader()->setResizeMode(3, QHeaderView::Stretch);
+	ui.tableWidget->horizontalHeader()->setResizeMode(4, QHeaderView::Stretch);
+
+	//no limits and free parameters for projects created before limits and fixed parameters were available
+	if (m_fitData->paramFixed.size() != m_fitData->paramNames.size()
+		|| m_fitData->paramLowerLimits.size() != m_fitData->paramNames.size()
+		|| m_fitData->paramUpperLimits.size() != m_fitData->paramNames.size()) {
+		m_fitData->paramFixed.fill(false, m_fitData->paramNames.size());
+		m_fitData->paramLowerLimits.fill(-DBL_MAX, m_fitData->paramNames.size());
+		m_fitData->paramUpperLimits.fill(DBL_MAX, m_fitData->paramNames.size());
+	}
 
 	if (m_fitData->modelType != XYFitCurve::Custom) {
 		ui.tableWidget->setRowCount(m_fitData->paramNames.size());
@@ -62,10 +88,12 @@ FitParametersWidget::FitParametersWidget(QWidget* parent, XYFitCurve::FitData* d
 			item->setBackground(QBrush(Qt::lightGray));
 			ui.tableWidget->setItem(i, 0, item);
 			ui.tableWidget->setItem(i, 1, new QTableWidgetItem(QString::number(m_fitData->paramStartValues.at(i), 'g')));
+			setLimitItems(i, m_fitData->paramFixed.at(i), m_fitData->paramLowerLimits.at(i), m_fitData->paramUpperLimits.at(i));
 		}
 		ui.tableWidget->setCurrentCell(0, 1);
 		ui.pbAdd->setVisible(false);
 		ui.pbRemove->setVisible(false);
+		ui.chkAutoStartValues->setChecked(m_fitData->autoStartValues);
 	} else {
 		if (m_fitData->paramNames.size()) {
 			//parameters for the custom model are already available -> show them
@@ -75,6 +103,7 @@ FitParametersWidget::FitParametersWidget(QWidget* parent, XYFitCurve::FitData* d
 				item->setBackground(QBrush(Qt::lightGray));
 				ui.tableWidget->setItem(i, 0, item);
 				ui.tableWidget->setItem(i, 1, new QTableWidgetItem(QString::number(m_fitData->paramStartValues.at(i), 'g')));
+				setLimitItems(i, m_fitData->paramFixed.at(i), m_fitData->paramLowerLimits.at(i), m_fitData->paramUpperLimits.at(i));
 			}
 		} else {
 			//no parameters available yet -> create the first row in the table for the first parameter
@@ -83,6 +112,7 @@ FitParametersWidget::FitParametersWidget(QWidget* parent, XYFitCurve::FitData* d
 			item->setBackground(QBrush(Qt::lightGray));
 			ui.tableWidget->setItem(0, 0, item);
 			ui.tableWidget->setItem(0, 1, new QTableWidgetItem());
+			setLimitItems(0, false, -DBL_MAX, DBL_MAX);
 		}
 		ui.tableWidget->setCurrentCell(0, 0);
 		ui.pbAdd->setIcon(KIcon("list-add"));
@@ -90,12 +120,14 @@ FitParametersWidget::FitParametersWidget(QWidget* parent, XYFitCurve::FitData* d
 		ui.pbRemove->setIcon(KIcon("list-remove"));
 		ui.pbRemove->setVisible(true);
 		ui.pbRemove->setEnabled(m_fitData->paramNames.size()>1);
+		ui.chkAutoStartValues->setVisible(false);
 	}
 
 	ui.tableWidget->installEventFilter(this);
 
 	//SLOTS
 	connect( ui.tableWidget, SIGNAL(cellChanged(int,int)), this, SLOT(changed()) );
+	connect( ui.chkAutoStartValues, SIGNAL(toggled(bool)), this, SLOT(changed()) );
 	connect( ui.pbApply, SIGNAL(clicked()), this, SLOT(applyClicked()) );
 	connect( ui.pbCancel, SIGNAL(clicked()), this, SIGNAL(finished()) );
 	connect( ui.pbAdd, SIGNAL(clicked()), this, SLOT(addParameter()) );
@@ -139,18 +171,43 @@ bool FitParametersWidget::eventFilter(QObject* watched, QEvent* event) {
 	return QWidget::eventFilter(watched, event);
 }
 
+/*!
+	sets the items for the fixed-flag and for the limits of the parameter in the row \c row.
+	Empty limits correspond to no limit (-DBL_MAX and DBL_MAX, respectively).
+*/
+void FitParametersWidget::setLimitItems(int row, bool fixed, double lowerLimit, double upperLimit) {
+	QTableWidgetItem* item = new QTableWidgetItem();
+	item->setFlags(Qt::ItemIsUserCheckable | Qt::ItemIsEnabled | Qt::ItemIsSelectable);
+	item->setCheckState(fixed ? Qt::Checked : Qt::Unchecked);
+	ui.tableWidget->setItem(row, 2, item);
+
+	ui.tableWidget->setItem(row, 3, new QTableWidgetItem(lowerLimit > -DBL_MAX ? QString::number(lowerLimit, 'g') : QString()));
+	ui.tableWidget->setItem(row, 4, new QTableWidgetItem(upperLimit < DBL_MAX ? QString::number(upperLimit, 'g') : QString()));
+}
+
 void FitParametersWidget::applyClicked() {
 	if (m_fitData->modelType != XYFitCurve::Custom) {
-		for (int i=0; i<ui.tableWidget->rowCount(); ++i)
+		for (int i=0; i<ui.tableWidget->rowCount(); ++i) {
 			m_fitData->paramStartValues[i] = ui.tableWidget->item(i,1)->text().toDouble();
+			m_fitData->paramFixed[i] = (ui.tableWidget->item(i,2)->checkState() == Qt::Checked);
+			m_fitData->paramLowerLimits[i] = lowerLimit(i);
+			m_fitData->paramUpperLimits[i] = upperLimit(i);
+		}
+		m_fitData->autoStartValues = ui.chkAutoStartValues->isChecked();
 	} else {
 		m_fitData->paramNames.clear();
 		m_fitData->paramStartValues.clear();
+		m_fitData->paramFixed.clear();
+		m_fitData->paramLowerLimits.clear();
+		m_fitData->paramUpperLimits.clear();
 		for (int i=0; i<ui.tableWidget->rowCount(); ++i) {
 			//skip those rows where either the name or the value are empty
 			if ( !ui.tableWidget->item(i,0)->text().simplified().isEmpty() && !ui.tableWidget->item(i,1)->text().simplified().isEmpty() ) {
 				m_fitData->paramNames.append( ui.tableWidget->item(i,0)->text() );
 				m_fitData->paramStartValues.append( ui.tableWidget->item(i,1)->text().toDouble() );
+				m_fitData->paramFixed.append( ui.tableWidget->item(i,2)->checkState() == Qt::Checked );
+				m_fitData->paramLowerLimits.append( lowerLimit(i) );
+				m_fitData->paramUpperLimits.append( upperLimit(i) );
 			}
 		}
 	}
@@ -168,6 +225,7 @@ void FitParametersWidget::addParameter() {
 	item->setBackground(QBrush(Qt::lightGray));
 	ui.tableWidget->setItem(rows, 0, item);
 	ui.tableWidget->setItem(rows, 1, new QTableWidgetItem());
+	setLimitItems(rows, false, -DBL_MAX, DBL_MAX);
 	ui.tableWidget->setCurrentCell(rows, 0);
 	ui.pbRemove->setEnabled(true);
 }
@@ -181,3 +239,13 @@ void FitParametersWidget::removeParameter() {
 void FitParametersWidget::changed() {
 	m_changed = true;
 }
+
+double FitParametersWidget::lowerLimit(int row) const {
+	const QString text = ui.tableWidget->item(row,3)->text().simplified();
+	return text.isEmpty() ? -DBL_MAX : text.toDouble();
+}
+
+double FitParametersWidget::upperLimit(int row) const {
+	const QString text = ui.tableWidget->item(row,4)->text().simplified();
+	return text.isEmpty() ? DBL_MAX : text.toDouble();
+}
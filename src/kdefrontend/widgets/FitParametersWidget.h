@@ -45,6 +45,9 @@ private:
 	XYFitCurve::FitData* m_fitData;
 	bool m_changed;
 	bool eventFilter( QObject * watched, QEvent * event);
+	void setLimitItems(int row, bool fixed, double lowerLimit, double upperLimit);
+	double lowerLimit(int row) const;
+	double upperLimit(int row) const;
 
 signals:
 	void finished();
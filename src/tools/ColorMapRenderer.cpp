@@ -32,15 +32,18 @@
 #include <QFile>
 #include <QPainter>
 
-QPixmap ColorMapRenderer::pixmap(const QString& fileName) {
+/*!
+  reads the colors of the colormap file \c fileName, returns an empty list if the file can't be opened.
+*/
+static QList<QColor> readColors(const QString& fileName) {
+	QList<QColor> list_rgb;
 	QFile file(fileName);
 	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)){
 		kDebug()<<"file "<<fileName<<" not found"<<endl;
-		return QPixmap();
+		return list_rgb;
 	}
 
 	QColor rgb;
-	QList<QColor> list_rgb;
 	int  red, green, blue;
 	QTextStream in(&file);
 
@@ -52,6 +55,15 @@ QPixmap ColorMapRenderer::pixmap(const QString& fileName) {
 //		kDebug()<<red<<"\t"<<green<<"\t"<<blue<<endl;
 	}
 
+	return list_rgb;
+}
+
+QPixmap ColorMapRenderer::pixmap(const QString& fileName) {
+	QList<QColor> list_rgb = readColors(fileName);
+	if (list_rgb.isEmpty())
+		return QPixmap();
+
+	QColor rgb;
 	int height=list_rgb.size();
 	int width=80;
 // 	kDebug()<<height<<"line read."<<endl;
@@ -65,3 +77,29 @@ QPixmap ColorMapRenderer::pixmap(const QString& fileName) {
 
 	return pixmap;
 }
+
+/*!
+  returns \c size colors interpolated linearly between the colors of the colormap file \c fileName,
+  the first color is used for the lowest values. If no file is given or the file can't be read,
+  the default colormap running from dark blue over cyan and yellow to red is used.
+*/
+QVector<QRgb> ColorMapRenderer::colorTable(const QString& fileName, int size) {
+	QList<QColor> colors;
+	if (!fileName.isEmpty())
+		colors = readColors(fileName);
+	if (colors.isEmpty())
+		colors << QColor(0, 0, 128) << QColor(0, 0, 255) << QColor(0, 255, 255) << QColor(255, 255, 0) << QColor(255, 0, 0);
+
+	QVector<QRgb> table(size);
+	for (int i=0; i<size; ++i) {
+		const double pos = (size > 1) ? (double)i*(colors.size()-1)/(size-1) : 0;
+		const int index = qMin((int)pos, colors.size()-1);
+		const QColor& c1 = colors.at(index);
+		const QColor& c2 = colors.at(qMin(index+1, colors.size()-1));
+		const double t = pos - index;
+		table[i] = qRgb( qRound(c1.red() + t*(c2.red()-c1.red())), qRound(c1.green() + t*(c2.green()-c1.green())),
+						qRound(c1.blue() + t*(c2.blue()-c1.blue())) );
+	}
+
+	return table;
+}
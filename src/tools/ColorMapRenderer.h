@@ -30,11 +30,13 @@
 #define COLORMAPRENDERER_H
 
 #include <QPixmap>
+#include <QVector>
 
 class ColorMapRenderer{
 
 public:
   static QPixmap pixmap( const QString& );
+  static QVector<QRgb> colorTable( const QString& fileName = QString(), int size = 256 );
 
 };
 
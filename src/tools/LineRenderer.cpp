@@ -0,0 +1,225 @@
+/***************************************************************************
+    File                 : LineRenderer.cpp
+    Project              : LabPlot
+    Description          : renderer for thin solid lines in raster images
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#include "LineRenderer.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QImage>
+
+#include <cmath>
+#include <algorithm>
+
+//pens up to this width in device pixels (hairlines and one pixel wide pens) are drawn, wider pens with QPainter
+static const qreal maxLineWidth = 1.0;
+
+//the image the lines are drawn into
+struct LineRaster {
+	uchar* bits;
+	int bytesPerLine;
+	int width;
+	int height;
+	QRgb color;	//premultiplied color of the pen
+};
+
+/*!
+  multiplies the four channels of the premultiplied color \c x with \c a (0..255).
+*/
+static inline QRgb byteMul(QRgb x, uint a) {
+	uint t = (x & 0xff00ff)*a;
+	t = (t + ((t >> 8) & 0xff00ff) + 0x800080) >> 8;
+	t &= 0xff00ff;
+
+	x = ((x >> 8) & 0xff00ff)*a;
+	x = (x + ((x >> 8) & 0xff00ff) + 0x800080);
+	x &= 0xff00ff00;
+
+	return x | t;
+}
+
+/*!
+  blends the color of the raster with the coverage \c coverage (0..255) over the pixel (\c x, \c y).
+*/
+static inline void plot(const LineRaster& raster, int x, int y, int coverage) {
+	if (coverage <= 0 || x < 0 || y < 0 || x >= raster.width || y >= raster.height)
+		return;
+
+	QRgb* pixel = reinterpret_cast<QRgb*>(raster.bits + y*raster.bytesPerLine) + x;
+	const QRgb src = byteMul(raster.color, coverage);
+	*pixel = src + byteMul(*pixel, 255 - qAlpha(src));
+}
+
+/*!
+  clips the line from \c p0 to \c p1 to \c rect (Liang-Barsky).
+  Returns \c false if the line is completely outside of \c rect.
+*/
+static bool clipSegment(QPointF& p0, QPointF& p1, const QRectF& rect) {
+	const qreal dx = p1.x() - p0.x();
+	const qreal dy = p1.y() - p0.y();
+	const qreal p[4] = {-dx, dx, -dy, dy};
+	const qreal q[4] = {p0.x() - rect.left(), rect.right() - p0.x(), p0.y() - rect.top(), rect.bottom() - p0.y()};
+
+	qreal t0 = 0, t1 = 1;
+	for (int i = 0; i < 4; ++i) {
+		if (p[i] == 0) {
+			if (q[i] < 0)
+				return false;
+			continue;
+		}
+
+		const qreal t = q[i]/p[i];
+		if (p[i] < 0)
+			t0 = qMax(t0, t);
+		else
+			t1 = qMin(t1, t);
+		if (t0 > t1)
+			return false;
+	}
+
+	const QPointF start = p0;
+	if (t1 < 1)
+		p1 = QPointF(start.x() + t1*dx, start.y() + t1*dy);
+	if (t0 > 0)
+		p0 = QPointF(start.x() + t0*dx, start.y() + t0*dy);
+
+	return true;
+}
+
+/*!
+  draws the antialiased line from \c p0 to \c p1 in device coordinates (Wu's algorithm):
+  along the major axis of the line the two pixels around the line are blended with the distance of the line to their centers.
+  The first pixel is skipped if \c connected is \c true, since it was already drawn by the previous line of the polyline.
+*/
+static void drawSegment(const LineRaster& raster, const QPointF& p0, const QPointF& p1, bool connected) {
+	//the pixel centers are at integer coordinates
+	qreal x0 = p0.x() - 0.5;
+	qreal y0 = p0.y() - 0.5;
+	qreal x1 = p1.x() - 0.5;
+	qreal y1 = p1.y() - 0.5;
+
+	const bool steep = fabs(y1 - y0) > fabs(x1 - x0);
+	if (steep) {
+		std::swap(x0, y0);
+		std::swap(x1, y1);
+	}
+
+	bool skipFirst = connected;
+	bool skipLast = false;
+	if (x0 > x1) {
+		std::swap(x0, x1);
+		std::swap(y0, y1);
+		std::swap(skipFirst, skipLast);
+	}
+
+	const qreal gradient = (x1 > x0) ? (y1 - y0)/(x1 - x0) : 0;
+	const int first = qRound(x0) + (skipFirst ? 1 : 0);
+	const int last = qRound(x1) - (skipLast ? 1 : 0);
+	for (int x = first; x <= last; ++x) {
+		const qreal y = y0 + gradient*(x - x0);
+		const int iy = (int)floor(y);
+		const int coverage = (int)((y - iy)*255 + 0.5);
+		if (steep) {
+			plot(raster, iy, x, 255 - coverage);
+			plot(raster, iy + 1, x, coverage);
+		} else {
+			plot(raster, x, iy, 255 - coverage);
+			plot(raster, x, iy + 1, coverage);
+		}
+	}
+}
+
+/*!
+  draws the polylines of \c path with the pen of \c painter directly into the image \c painter is painting on.
+  This is much faster than QPainter::drawPath() for large paths consisting of many lines.
+  Returns \c false without drawing if the path has to be drawn with QPainter: for other paint devices than
+  images (vector export, printing and the screen), for dashed, wide or non-solid pens, curved paths,
+  clipping, other composition modes than SourceOver, rotations and for painting without antialiasing.
+*/
+bool LineRenderer::drawPath(QPainter* painter, const QPainterPath& path) {
+	QPaintDevice* device = painter->device();
+	if (!device || device->devType() != QInternal::Image)
+		return false;
+
+	QImage* image = static_cast<QImage*>(device);
+	if (image->format() != QImage::Format_ARGB32_Premultiplied && image->format() != QImage::Format_RGB32)
+		return false;
+
+	const QPen& pen = painter->pen();
+	const QTransform trafo = painter->combinedTransform();
+	if (pen.style() != Qt::SolidLine || pen.brush().style() != Qt::SolidPattern
+			|| !painter->testRenderHint(QPainter::Antialiasing) || painter->hasClipping()
+			|| painter->compositionMode() != QPainter::CompositionMode_SourceOver
+			|| trafo.type() > QTransform::TxScale)
+		return false;
+
+	//width of the pen in device pixels, cosmetic pens are not transformed
+	qreal width = pen.widthF();
+	if (!pen.isCosmetic())
+		width *= qMax(fabs(trafo.m11()), fabs(trafo.m22()));
+	if (width > maxLineWidth && !qFuzzyCompare(width, maxLineWidth))
+		return false;
+
+	for (int i = 0; i < path.elementCount(); ++i) {
+		if (path.elementAt(i).type == QPainterPath::CurveToElement)
+			return false;
+	}
+
+	//lines thinner than one pixel are drawn with less opacity
+	QColor color = pen.color();
+	color.setAlphaF(color.alphaF()*painter->opacity()*((width > 0 && width < 1) ? width : 1));
+	const int alpha = color.alpha();
+	if (alpha == 0)
+		return true;
+
+	LineRaster raster;
+	raster.bits = image->bits();
+	raster.bytesPerLine = image->bytesPerLine();
+	raster.width = image->width();
+	raster.height = image->height();
+	raster.color = qRgba(color.red()*alpha/255, color.green()*alpha/255, color.blue()*alpha/255, alpha);
+
+	//lines are clipped with a margin, so that the blending at the borders of the image is kept
+	const QRectF clipRect(-2, -2, raster.width + 4, raster.height + 4);
+	QPointF lastPoint;
+	bool connected = false;
+	for (int i = 0; i < path.elementCount(); ++i) {
+		const QPainterPath::Element& element = path.elementAt(i);
+		const QPointF point = trafo.map(QPointF(element.x, element.y));
+		if (element.type == QPainterPath::LineToElement) {
+			QPointF p0 = lastPoint;
+			QPointF p1 = point;
+			if (clipSegment(p0, p1, clipRect))
+				drawSegment(raster, p0, p1, connected);
+			connected = true;
+		} else {
+			connected = false;
+		}
+		lastPoint = point;
+	}
+
+	return true;
+}
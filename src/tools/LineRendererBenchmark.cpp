@@ -0,0 +1,163 @@
+/***************************************************************************
+    File                 : LineRendererBenchmark.cpp
+    Project              : LabPlot
+    Description          : benchmark of LineRenderer against QPainter
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 agent (agent@local)
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#include "LineRenderer.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <QVector>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+static const int imageWidth = 1600;
+static const int imageHeight = 1000;
+static const int points = 100000;
+static const int repetitions = 10;
+
+/* random walk in the image, with many points per pixel column like a large curve */
+static QVector<QPointF> randomWalk() {
+	QVector<QPointF> walk(points);
+	double y = imageHeight/2.;
+	srand(1);
+	for (int i = 0; i < points; ++i) {
+		y += 4.*rand()/RAND_MAX - 2.;
+		y = qBound(0., y, (double)imageHeight);
+		walk[i] = QPointF(i*(double)imageWidth/points, y);
+	}
+	return walk;
+}
+
+/* XYCurve::Line */
+static QPainterPath linePath(const QVector<QPointF>& walk) {
+	QPainterPath path(walk.at(0));
+	for (int i = 1; i < walk.size(); ++i)
+		path.lineTo(walk.at(i));
+	return path;
+}
+
+/* XYCurve::StartHorizontal */
+static QPainterPath stepsPath(const QVector<QPointF>& walk) {
+	QPainterPath path(walk.at(0));
+	for (int i = 1; i < walk.size(); ++i) {
+		path.lineTo(walk.at(i).x(), walk.at(i-1).y());
+		path.lineTo(walk.at(i));
+	}
+	return path;
+}
+
+/* XYCurve::Segments2 */
+static QPainterPath segmentsPath(const QVector<QPointF>& walk) {
+	QPainterPath path;
+	for (int i = 0; i + 1 < walk.size(); i += 2) {
+		path.moveTo(walk.at(i));
+		path.lineTo(walk.at(i+1));
+	}
+	return path;
+}
+
+/* XYCurve::DropLineY, drop lines to the bottom of the image */
+static QPainterPath dropLinesPath(const QVector<QPointF>& walk) {
+	QPainterPath path;
+	for (int i = 0; i < walk.size(); ++i) {
+		path.moveTo(walk.at(i));
+		path.lineTo(walk.at(i).x(), imageHeight);
+	}
+	return path;
+}
+
+/* mean time in ms for drawing path into image, with LineRenderer if fast is true */
+static double drawingTime(const QPainterPath& path, const QPen& pen, bool fast, QImage& image, bool& fallback) {
+	QElapsedTimer timer;
+	qint64 elapsed = 0;
+	fallback = false;
+	for (int i = 0; i < repetitions; ++i) {
+		image.fill(0);
+		QPainter painter(&image);
+		painter.setRenderHint(QPainter::Antialiasing, true);
+		painter.setPen(pen);
+		painter.setBrush(Qt::NoBrush);
+		timer.start();
+		if (!fast || !LineRenderer::drawPath(&painter, path)) {
+			fallback = fast;
+			painter.drawPath(path);
+		}
+		elapsed += timer.nsecsElapsed();
+		painter.end();
+	}
+
+	return elapsed/1.e6/repetitions;
+}
+
+/* mean difference of the alpha channels in percent, over the pixels drawn in one of the images */
+static double difference(const QImage& a, const QImage& b) {
+	double sum = 0;
+	int count = 0;
+	for (int y = 0; y < a.height(); ++y) {
+		const QRgb* lineA = reinterpret_cast<const QRgb*>(a.constScanLine(y));
+		const QRgb* lineB = reinterpret_cast<const QRgb*>(b.constScanLine(y));
+		for (int x = 0; x < a.width(); ++x) {
+			if (qAlpha(lineA[x]) == 0 && qAlpha(lineB[x]) == 0)
+				continue;
+			sum += abs(qAlpha(lineA[x]) - qAlpha(lineB[x]));
+			++count;
+		}
+	}
+
+	return count ? 100.*sum/(255.*count) : 0;
+}
+
+int main(int argc, char** argv) {
+	QApplication app(argc, argv, false);
+
+	const QVector<QPointF> walk = randomWalk();
+	const char* names[4] = {"line", "steps", "segments", "drop lines"};
+	const QPainterPath paths[4] = {linePath(walk), stepsPath(walk), segmentsPath(walk), dropLinesPath(walk)};
+	const char* penNames[2] = {"hairline", "1 px"};
+	const QPen pens[2] = {QPen(Qt::black, 0), QPen(Qt::black, 1)};
+
+	QImage reference(imageWidth, imageHeight, QImage::Format_ARGB32_Premultiplied);
+	QImage image(imageWidth, imageHeight, QImage::Format_ARGB32_Premultiplied);
+
+	printf("%d points, %dx%d image, mean of %d runs\n", points, imageWidth, imageHeight, repetitions);
+	printf("%-12s%-10s%14s%14s%12s\n", "line type", "pen", "QPainter", "LineRenderer", "difference");
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 2; ++j) {
+			bool fallback;
+			const double qpainterTime = drawingTime(paths[i], pens[j], false, reference, fallback);
+			const double rendererTime = drawingTime(paths[i], pens[j], true, image, fallback);
+			printf("%-12s%-10s%11.2f ms%11.2f ms%10.2f %%%s\n", names[i], penNames[j], qpainterTime, rendererTime,
+				difference(reference, image), fallback ? " (QPainter fallback)" : "");
+		}
+	}
+
+	return 0;
+}